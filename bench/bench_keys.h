@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifndef BENCH_KEYS_H
+#define BENCH_KEYS_H
+
+namespace bench {
+enum KeyPattern { kSorted = 0, kRandom = 1, kZipfian = 2 };
+
+inline const char *PatternName(int pattern) {
+  switch (pattern) {
+  case kSorted:
+    return "sorted";
+  case kRandom:
+    return "random";
+  default:
+    return "zipfian";
+  }
+}
+
+// `n` keys in the given pattern. Random keys are a shuffled permutation of
+// [0, n); Zipfian keys are drawn from [0, n) with exponent 0.99, so a few
+// hot keys repeat many times. Seeded, so every run sees the same keys.
+inline std::vector<long> MakeKeys(long n, int pattern, unsigned seed = 42) {
+  std::vector<long> keys(n);
+  std::mt19937_64 rng(seed);
+  if (pattern == kZipfian) {
+    std::vector<double> cdf(n);
+    double sum = 0;
+    for (long i = 0; i < n; ++i) {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), 0.99);
+      cdf[i] = sum;
+    }
+    std::uniform_real_distribution<double> uniform(0.0, sum);
+    for (long &key : keys) {
+      key = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) -
+            cdf.begin();
+    }
+    // Scatter the hot ranks over the key space.
+    for (long &key : keys) {
+      key = static_cast<long>((static_cast<std::uint64_t>(key) *
+                               0x9E3779B97F4A7C15ull) %
+                              static_cast<std::uint64_t>(n));
+    }
+    return keys;
+  }
+  for (long i = 0; i < n; ++i) {
+    keys[i] = i;
+  }
+  if (pattern == kRandom) {
+    std::shuffle(keys.begin(), keys.end(), rng);
+  }
+  return keys;
+}
+
+}
+
+#endif
@@ -0,0 +1,394 @@
+#include "../include/s21/s21_containers.h"
+#include "bench_keys.h"
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+static std::vector<std::pair<const long, long>> SortedInput(long n) {
+  std::vector<std::pair<const long, long>> input;
+  input.reserve(n);
+  for (long i = 0; i < n; ++i) {
+    input.emplace_back(i, i);
+  }
+  return input;
+}
+
+// Baseline: one insert per element, as the range constructor used to do.
+static void BM_BuildByInsert(benchmark::State &state) {
+  auto input = SortedInput(state.range(0));
+  for (auto _ : state) {
+    s21::map<long, long> map;
+    for (const auto &item : input) {
+      map.insert(item);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BuildRange(benchmark::State &state) {
+  auto input = SortedInput(state.range(0));
+  for (auto _ : state) {
+    s21::map<long, long> map(input.begin(), input.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BuildSortedUnique(benchmark::State &state) {
+  auto input = SortedInput(state.range(0));
+  for (auto _ : state) {
+    s21::map<long, long> map(s21::sorted_unique, input.begin(), input.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_BuildStdMap(benchmark::State &state) {
+  auto input = SortedInput(state.range(0));
+  for (auto _ : state) {
+    std::map<long, long> map(input.begin(), input.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Start-up from a file written by map::save(): load() rebuilds the tree,
+// load_mapped() only maps the file and checks its header.
+static const std::string kSnapshotPath = "/tmp/s21_bench_map.snapshot";
+
+static void SaveSnapshot(long n) {
+  auto input = SortedInput(n);
+  s21::map<long, long>(s21::sorted_unique, input.begin(), input.end())
+      .save(kSnapshotPath);
+}
+
+static void BM_SnapshotLoad(benchmark::State &state) {
+  SaveSnapshot(state.range(0));
+  for (auto _ : state) {
+    auto map = s21::map<long, long>::load(kSnapshotPath);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SnapshotLoadMapped(benchmark::State &state) {
+  SaveSnapshot(state.range(0));
+  for (auto _ : state) {
+    auto view = s21::map<long, long>::load_mapped(kSnapshotPath);
+    benchmark::DoNotOptimize(view.contains(state.range(0) / 2));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SnapshotMappedLookup(benchmark::State &state) {
+  auto keys = bench::MakeKeys(state.range(0), static_cast<int>(state.range(1)));
+  state.SetLabel(bench::PatternName(static_cast<int>(state.range(1))));
+  SaveSnapshot(state.range(0));
+  auto view = s21::map<long, long>::load_mapped(kSnapshotPath);
+  for (auto _ : state) {
+    long found = 0;
+    for (long key : keys) {
+      found += view.find(key) != view.end();
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// Maps are benchmarked under three key patterns (range(1)): sorted, random
+// and Zipfian; see bench_keys.h.
+template <typename Map> static void BM_MapInsert(benchmark::State &state) {
+  auto keys = bench::MakeKeys(state.range(0), static_cast<int>(state.range(1)));
+  state.SetLabel(bench::PatternName(static_cast<int>(state.range(1))));
+  for (auto _ : state) {
+    Map map;
+    for (long key : keys) {
+      map.insert({key, key});
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map> static void BM_MapLookup(benchmark::State &state) {
+  auto keys = bench::MakeKeys(state.range(0), static_cast<int>(state.range(1)));
+  state.SetLabel(bench::PatternName(static_cast<int>(state.range(1))));
+  Map map;
+  for (long i = 0; i < state.range(0); ++i) {
+    map.insert({i, i});
+  }
+  for (auto _ : state) {
+    long found = 0;
+    for (long key : keys) {
+      found += map.find(key) != map.end();
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map> static void BM_MapErase(benchmark::State &state) {
+  auto keys = bench::MakeKeys(state.range(0), static_cast<int>(state.range(1)));
+  state.SetLabel(bench::PatternName(static_cast<int>(state.range(1))));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Map map;
+    for (long i = 0; i < state.range(0); ++i) {
+      map.insert({i, i});
+    }
+    state.ResumeTiming();
+    for (long key : keys) {
+      auto it = map.find(key);
+      if (it != map.end()) {
+        map.erase(it);
+      }
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map> static void BM_MapIterate(benchmark::State &state) {
+  auto keys = bench::MakeKeys(state.range(0), static_cast<int>(state.range(1)));
+  state.SetLabel(bench::PatternName(static_cast<int>(state.range(1))));
+  Map map;
+  for (long key : keys) {
+    map.insert({key, key});
+  }
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+      sum += it->second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * map.size());
+}
+
+// Short ordered scans from a random start: one descent, then `range(1)`
+// successive elements.
+template <typename Map> static void BM_MapScan(benchmark::State &state) {
+  auto starts = bench::MakeKeys(10000, bench::kRandom);
+  for (long &start : starts) {
+    start *= state.range(0) / 10000;
+  }
+  Map map;
+  for (long i = 0; i < state.range(0); ++i) {
+    map.insert({i, i});
+  }
+  for (auto _ : state) {
+    long sum = 0;
+    for (long start : starts) {
+      auto it = map.lower_bound(start);
+      for (long i = 0; i < state.range(1) && it != map.end(); ++i, ++it) {
+        sum += it->second;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * starts.size() * state.range(1));
+}
+
+// Heap bytes held per element after inserting random keys, reported as the
+// `bytes_per_item` counter. Needs glibc's mallinfo2; elsewhere it reports 0.
+template <typename Map> static void BM_MapMemory(benchmark::State &state) {
+  auto keys = bench::MakeKeys(state.range(0), bench::kRandom);
+  double bytes_per_item = 0;
+  for (auto _ : state) {
+#ifdef __GLIBC__
+    size_t before = mallinfo2().uordblks;
+#endif
+    Map map;
+    for (long key : keys) {
+      map.insert({key, key});
+    }
+#ifdef __GLIBC__
+    bytes_per_item = static_cast<double>(mallinfo2().uordblks - before) /
+                     static_cast<double>(map.size());
+#endif
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.counters["bytes_per_item"] = bytes_per_item;
+}
+
+// Lookup-heavy mix over even keys 0..2n: of every 10000 operations,
+// range(1) insert a missing odd key and erase it again; the rest are finds.
+template <typename Map> static void BM_MapReadMostly(benchmark::State &state) {
+  const long n = state.range(0);
+  const long writes = state.range(1);
+  auto keys = bench::MakeKeys(10000, bench::kRandom);
+  Map map;
+  for (long i = 0; i < n; ++i) {
+    map.insert({2 * i, i});
+  }
+  const long stride = writes == 0 ? 0 : 10000 / writes;
+  for (auto _ : state) {
+    long found = 0;
+    for (long op = 0; op < 10000; ++op) {
+      long key = 2 * (keys[op] * (n / 10000));
+      if (stride != 0 && op % stride == 0) {
+        map.insert({key + 1, op});
+        map.erase(map.find(key + 1));
+      } else {
+        found += map.find(key) != map.end();
+      }
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+
+// Baseline for concurrent_map: s21::map behind a single reader-writer lock.
+class LockedMap {
+public:
+  bool contains(long key) const {
+    std::shared_lock lock(mutex_);
+    return map_.contains(key);
+  }
+
+  bool insert(long key, long value) {
+    std::unique_lock lock(mutex_);
+    return map_.insert({key, value}).second;
+  }
+
+  size_t erase(long key) {
+    std::unique_lock lock(mutex_);
+    auto it = map_.find(key);
+    if (it == map_.end()) {
+      return 0;
+    }
+    map_.erase(it);
+    return 1;
+  }
+
+private:
+  mutable std::shared_mutex mutex_;
+  s21::map<long, long> map_;
+};
+
+// Every thread runs the same mix over one shared map of 10^5 even keys;
+// range(0) is the percentage of operations that write (an insert of an odd
+// key and its erase). Thread 0 builds the map before the threads start and
+// frees it after they all stop.
+template <typename Map>
+static void BM_ConcurrentMapMix(benchmark::State &state) {
+  static Map *map = nullptr;
+  constexpr long n = 100000;
+  const long write_percent = state.range(0);
+  if (state.thread_index() == 0) {
+    map = new Map;
+    for (long i = 0; i < n; ++i) {
+      map->insert(2 * i, i);
+    }
+  }
+  auto keys = bench::MakeKeys(n, bench::kRandom,
+                              42 + static_cast<unsigned>(state.thread_index()));
+  long op = 0;
+  for (auto _ : state) {
+    long found = 0;
+    for (int i = 0; i < 1000; ++i, ++op) {
+      long key = 2 * keys[op % n];
+      if (op % 100 < write_percent) {
+        map->insert(key + 1, op);
+        map->erase(key + 1);
+      } else {
+        found += map->contains(key);
+      }
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * 1000);
+  if (state.thread_index() == 0) {
+    delete map;
+    map = nullptr;
+  }
+}
+
+static void MapArgs(benchmark::internal::Benchmark *b) {
+  for (long n : {10000L, 1000000L}) {
+    for (int pattern : {bench::kSorted, bench::kRandom, bench::kZipfian}) {
+      b->Args({n, pattern});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+using S21Map = s21::map<long, long>;
+using StdMap = std::map<long, long>;
+using BTreeMap = s21::btree_map<long, long>;
+using HashMap = s21::unordered_map<long, long>;
+using StdHashMap = std::unordered_map<long, long>;
+using FlatMap = s21::flat_map<long, long>;
+using ConcurrentMap = s21::concurrent_map<long, long>;
+
+BENCHMARK(BM_MapInsert<S21Map>)->Apply(MapArgs);
+BENCHMARK(BM_MapInsert<StdMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapInsert<BTreeMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapInsert<HashMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapInsert<StdHashMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapLookup<S21Map>)->Apply(MapArgs);
+BENCHMARK(BM_MapLookup<StdMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapLookup<BTreeMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapLookup<HashMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapLookup<StdHashMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapLookup<FlatMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapErase<S21Map>)->Apply(MapArgs);
+BENCHMARK(BM_MapErase<StdMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapErase<BTreeMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapErase<HashMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapErase<StdHashMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapIterate<S21Map>)->Apply(MapArgs);
+BENCHMARK(BM_MapIterate<StdMap>)->Apply(MapArgs);
+BENCHMARK(BM_MapIterate<BTreeMap>)->Apply(MapArgs);
+
+static void ScanArgs(benchmark::internal::Benchmark *b) {
+  for (long n : {1000000L, 10000000L}) {
+    for (long length : {16L, 256L}) {
+      b->Args({n, length});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+static void ReadMostlyArgs(benchmark::internal::Benchmark *b) {
+  for (long n : {100000L, 1000000L}) {
+    for (long writes : {0L, 1L, 10L}) {
+      b->Args({n, writes});
+    }
+  }
+  b->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK(BM_MapReadMostly<S21Map>)->Apply(ReadMostlyArgs);
+BENCHMARK(BM_MapReadMostly<BTreeMap>)->Apply(ReadMostlyArgs);
+BENCHMARK(BM_MapReadMostly<FlatMap>)->Apply(ReadMostlyArgs);
+
+BENCHMARK(BM_ConcurrentMapMix<LockedMap>)->Arg(0)->Arg(10)->Arg(50)->ThreadRange(1, 64)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConcurrentMapMix<ConcurrentMap>)->Arg(0)->Arg(10)->Arg(50)->ThreadRange(1, 64)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_MapScan<S21Map>)->Apply(ScanArgs);
+BENCHMARK(BM_MapScan<StdMap>)->Apply(ScanArgs);
+BENCHMARK(BM_MapScan<BTreeMap>)->Apply(ScanArgs);
+BENCHMARK(BM_MapMemory<S21Map>)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapMemory<StdMap>)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapMemory<BTreeMap>)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapMemory<HashMap>)->Arg(1000000)->Arg(10000000)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_BuildByInsert)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BuildRange)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BuildSortedUnique)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BuildStdMap)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_SnapshotLoad)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SnapshotLoadMapped)->RangeMultiplier(10)->Range(100000, 10000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SnapshotMappedLookup)->Apply(MapArgs);
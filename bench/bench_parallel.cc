@@ -0,0 +1,145 @@
+#include "../include/s21/s21_containers.h"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+
+// Scaling of the s21::parallel algorithms over a 16M-element vector, with
+// range(0) threads from 1 up to the machine's cores. The std:: algorithms
+// on one thread are the baseline.
+static constexpr size_t kParallelSize = size_t{1} << 24;
+
+static const s21::vector<int> &ParallelInput() {
+  static const s21::vector<int> input = [] {
+    std::mt19937 gen(42);
+    s21::vector<int> v;
+    v.reserve(kParallelSize);
+    for (size_t i = 0; i < kParallelSize; ++i) {
+      v.push_back(static_cast<int>(gen() % 1000000));
+    }
+    return v;
+  }();
+  return input;
+}
+
+static void ThreadCounts(benchmark::internal::Benchmark *b) {
+  size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads < cores; threads *= 2) {
+    b->Arg(static_cast<long>(threads));
+  }
+  b->Arg(static_cast<long>(cores));
+  b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+static void BM_ParallelSort(benchmark::State &state) {
+  s21::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+  s21::vector<int> v;
+  for (auto _ : state) {
+    state.PauseTiming();
+    v = ParallelInput();
+    state.ResumeTiming();
+    s21::parallel::sort(pool, v.begin(), v.end());
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_StdSort(benchmark::State &state) {
+  s21::vector<int> v;
+  for (auto _ : state) {
+    state.PauseTiming();
+    v = ParallelInput();
+    state.ResumeTiming();
+    std::sort(v.begin(), v.end());
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_ParallelTransform(benchmark::State &state) {
+  s21::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+  const s21::vector<int> &in = ParallelInput();
+  s21::vector<float> out(kParallelSize);
+  for (auto _ : state) {
+    s21::parallel::transform(pool, in.begin(), in.end(), out.begin(),
+                             [](int x) { return std::sqrt(float(x)); });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_StdTransform(benchmark::State &state) {
+  const s21::vector<int> &in = ParallelInput();
+  s21::vector<float> out(kParallelSize);
+  for (auto _ : state) {
+    std::transform(in.begin(), in.end(), out.begin(),
+                   [](int x) { return std::sqrt(float(x)); });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_ParallelReduce(benchmark::State &state) {
+  s21::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+  const s21::vector<int> &in = ParallelInput();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        s21::parallel::reduce(pool, in.begin(), in.end(), 0L));
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_StdReduce(benchmark::State &state) {
+  const s21::vector<int> &in = ParallelInput();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(std::reduce(in.begin(), in.end(), 0L));
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_ParallelInclusiveScan(benchmark::State &state) {
+  s21::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+  const s21::vector<int> &in = ParallelInput();
+  s21::vector<int> out(kParallelSize);
+  for (auto _ : state) {
+    s21::parallel::inclusive_scan(pool, in.begin(), in.end(), out.begin());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_ParallelCopyIf(benchmark::State &state) {
+  s21::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+  const s21::vector<int> &in = ParallelInput();
+  s21::vector<int> out(kParallelSize);
+  for (auto _ : state) {
+    auto end = s21::parallel::copy_if(pool, in.begin(), in.end(), out.begin(),
+                                      [](int x) { return x % 3 == 0; });
+    benchmark::DoNotOptimize(end);
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+static void BM_ParallelForEach(benchmark::State &state) {
+  s21::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+  s21::vector<int> v = ParallelInput();
+  for (auto _ : state) {
+    s21::parallel::for_each(pool, v.begin(), v.end(),
+                            [](int &x) { x = x * 3 + 1; });
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kParallelSize);
+}
+
+BENCHMARK(BM_StdSort)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelSort)->Apply(ThreadCounts);
+BENCHMARK(BM_StdTransform)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelTransform)->Apply(ThreadCounts);
+BENCHMARK(BM_StdReduce)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelReduce)->Apply(ThreadCounts);
+BENCHMARK(BM_ParallelInclusiveScan)->Apply(ThreadCounts);
+BENCHMARK(BM_ParallelCopyIf)->Apply(ThreadCounts);
+BENCHMARK(BM_ParallelForEach)->Apply(ThreadCounts);
@@ -0,0 +1,166 @@
+#include "../include/s21/s21_containers.h"
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fill a queue to `n` elements, then measure push+pop pairs at that depth.
+// Per-op cost should stay flat as `n` grows.
+template <typename Queue> static void BM_SteadyState(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  Queue queue;
+  for (int i = 0; i < n; ++i) {
+    queue.push(i);
+  }
+  int next = n;
+  for (auto _ : state) {
+    queue.push(next++);
+    benchmark::DoNotOptimize(queue.front());
+    queue.pop();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Push `n` elements, then drain them all.
+template <typename Queue> static void BM_FillDrain(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Queue queue;
+    for (int i = 0; i < n; ++i) {
+      queue.push(i);
+    }
+    while (!queue.empty()) {
+      benchmark::DoNotOptimize(queue.front());
+      queue.pop();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_SteadyState<s21::queue<int>>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_SteadyState<std::queue<int>>)->RangeMultiplier(10)->Range(1000, 10000000);
+BENCHMARK(BM_FillDrain<s21::queue<int>>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FillDrain<std::queue<int>>)->RangeMultiplier(10)->Range(1000, 10000000)->Unit(benchmark::kMillisecond);
+
+// Baseline for the lock-free queues: s21::queue behind a mutex, which is
+// what callers used before.
+class LockedQueue {
+public:
+  explicit LockedQueue(size_t) {}
+
+  bool try_push(long value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+    return true;
+  }
+
+  bool try_pop(long &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    out = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+private:
+  std::mutex mutex_;
+  s21::queue<long> queue_;
+};
+
+template <typename Queue>
+static void PushOne(Queue &queue, long value) {
+  while (!queue.try_push(value)) {
+    std::this_thread::yield();
+  }
+}
+
+template <typename Queue>
+static void PushBatch(Queue &queue, const long *first, const long *last) {
+  while (first != last) {
+    size_t pushed = queue.try_push_batch(first, last);
+    if (pushed == 0) {
+      std::this_thread::yield();
+    }
+    first += pushed;
+  }
+}
+
+// Moves kHandoffItems values from range(0) producer threads to range(1)
+// consumer threads through a 1024-slot queue; wall time per item. With
+// Batch, both sides move up to 32 values per call.
+constexpr long kHandoffItems = 1000000;
+
+template <typename Queue, bool Batch>
+static void BM_Handoff(benchmark::State &state) {
+  const int producers = static_cast<int>(state.range(0));
+  const int consumers = static_cast<int>(state.range(1));
+  const long per_producer = kHandoffItems / producers;
+  const long total = per_producer * producers;
+  for (auto _ : state) {
+    Queue queue(1024);
+    std::atomic<long> consumed{0};
+    std::atomic<long> checksum{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p] {
+        long first = p * per_producer;
+        long last = first + per_producer;
+        if constexpr (Batch) {
+          long batch[32];
+          for (long i = first; i < last; i += 32) {
+            long n = last - i < 32 ? last - i : 32;
+            for (long j = 0; j < n; ++j) {
+              batch[j] = i + j;
+            }
+            PushBatch(queue, batch, batch + n);
+          }
+        } else {
+          for (long i = first; i < last; ++i) {
+            PushOne(queue, i);
+          }
+        }
+      });
+    }
+    for (int c = 0; c < consumers; ++c) {
+      threads.emplace_back([&] {
+        long sum = 0;
+        long batch[32];
+        while (consumed.load(std::memory_order_relaxed) < total) {
+          size_t n = 0;
+          if constexpr (Batch) {
+            n = queue.try_pop_batch(batch, 32);
+          } else {
+            n = queue.try_pop(batch[0]) ? 1 : 0;
+          }
+          if (n == 0) {
+            std::this_thread::yield();
+            continue;
+          }
+          for (size_t j = 0; j < n; ++j) {
+            sum += batch[j];
+          }
+          consumed.fetch_add(static_cast<long>(n), std::memory_order_relaxed);
+        }
+        checksum.fetch_add(sum);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    if (checksum.load() != total * (total - 1) / 2) {
+      state.SkipWithError("lost or duplicated items");
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * total);
+}
+
+BENCHMARK(BM_Handoff<LockedQueue, false>)->Args({1, 1})->Args({4, 4})->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Handoff<s21::spsc_queue<long>, false>)->Args({1, 1})->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Handoff<s21::spsc_queue<long>, true>)->Args({1, 1})->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Handoff<s21::mpmc_queue<long>, false>)->Args({1, 1})->Args({4, 4})->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Handoff<s21::mpmc_queue<long>, true>)->Args({1, 1})->Args({4, 4})->UseRealTime()->Unit(benchmark::kMillisecond);
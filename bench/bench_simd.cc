@@ -0,0 +1,100 @@
+#include "../include/s21/s21_containers.h"
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+// The s21::simd kernels behind vector::find, count, minmax and ==, at each
+// level the CPU supports (range(1): 0 scalar, 1 SSE2, 2 AVX2, 3 AVX-512)
+// over range(0) elements. The scalar level is the hand-written loop the
+// vector members replace.
+template <typename T> static s21::vector<T> SimdInput(size_t n) {
+  std::mt19937 gen(42);
+  s21::vector<T> v;
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    v.push_back(static_cast<T>(gen() % 100));
+  }
+  return v;
+}
+
+// Selects the level under test, or skips it on a CPU without it.
+static bool SelectLevel(benchmark::State &state) {
+  auto wanted = static_cast<s21::simd::level>(state.range(1));
+  if (wanted > s21::simd::detected_level()) {
+    state.SkipWithError("level not supported by this CPU");
+    return false;
+  }
+  s21::simd::set_level(wanted);
+  return true;
+}
+
+static void SimdSizes(benchmark::internal::Benchmark *b) {
+  for (long n : {1000L, 100000L, 10000000L, 100000000L}) {
+    for (long l = 0; l <= 3; ++l) {
+      b->Args({n, l});
+    }
+  }
+  b->ArgNames({"n", "level"});
+}
+
+// A value that is not there, so every element is compared.
+template <typename T> static void BM_SimdFind(benchmark::State &state) {
+  if (!SelectLevel(state)) {
+    return;
+  }
+  s21::vector<T> v = SimdInput<T>(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v.find(T(100)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+  s21::simd::set_level(s21::simd::detected_level());
+}
+
+template <typename T> static void BM_SimdCount(benchmark::State &state) {
+  if (!SelectLevel(state)) {
+    return;
+  }
+  s21::vector<T> v = SimdInput<T>(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v.count(T(7)));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+  s21::simd::set_level(s21::simd::detected_level());
+}
+
+template <typename T> static void BM_SimdMinmax(benchmark::State &state) {
+  if (!SelectLevel(state)) {
+    return;
+  }
+  s21::vector<T> v = SimdInput<T>(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(v.minmax());
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+  s21::simd::set_level(s21::simd::detected_level());
+}
+
+// Two equal vectors, so the comparison reads both to the end.
+template <typename T> static void BM_SimdEqual(benchmark::State &state) {
+  if (!SelectLevel(state)) {
+    return;
+  }
+  s21::vector<T> a = SimdInput<T>(static_cast<size_t>(state.range(0)));
+  s21::vector<T> b = a;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a == b);
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * 2 * sizeof(T));
+  s21::simd::set_level(s21::simd::detected_level());
+}
+
+BENCHMARK_TEMPLATE(BM_SimdFind, std::uint8_t)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdFind, int)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdFind, float)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdCount, std::uint8_t)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdCount, int)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdMinmax, int)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdMinmax, float)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdEqual, std::uint8_t)->Apply(SimdSizes);
+BENCHMARK_TEMPLATE(BM_SimdEqual, int)->Apply(SimdSizes);
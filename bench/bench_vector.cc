@@ -0,0 +1,425 @@
+#include "../include/s21/s21_containers.h"
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <fstream>
+#include <span>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// Forwards to std::allocator and counts allocate() calls, so the short-lived
+// vector benchmarks can report heap allocations per vector.
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+  static inline long allocations = 0;
+
+  CountingAllocator() = default;
+  template <typename U> CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    ++allocations;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) noexcept {
+    std::allocator<T>().deallocate(p, n);
+  }
+  bool operator==(const CountingAllocator &) const { return true; }
+};
+
+// Builds and drops a vector of `n` ints, the pattern of many short-lived
+// per-call vectors.
+template <typename Vector>
+static void BM_ShortLivedVector(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  CountingAllocator<int>::allocations = 0;
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(i);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.counters["allocs_per_vector"] = benchmark::Counter(
+      static_cast<double>(CountingAllocator<int>::allocations),
+      benchmark::Counter::kAvgIterations);
+}
+
+using HeapFloats = s21::vector<float>;
+using MappedFloats = s21::vector<float, s21::mmap_allocator<float>>;
+
+// Grows a vector of floats to range(0) MiB one push_back at a time. With
+// mmap_allocator every doubling past 2 MiB is an mremap instead of a copy.
+template <typename Vector> static void BM_GrowLarge(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0)) << 20 >> 2;
+  for (auto _ : state) {
+    Vector v;
+    for (size_t i = 0; i < n; ++i) {
+      v.push_back(static_cast<float>(i));
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(float));
+}
+
+// Checkpoints a range(0) MiB vector of floats to a file and reads it back:
+// element by element through iostreams, the way it was done before
+// write_to/read_from, and as one binary dump.
+static const char *kDumpPath = "/tmp/s21_bench_vector.dump";
+
+static s21::vector<float> DumpInput(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0)) << 20 >> 2;
+  s21::vector<float> v;
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    v.push_back(static_cast<float>(i));
+  }
+  return v;
+}
+
+static void BM_DumpElementwise(benchmark::State &state) {
+  s21::vector<float> v = DumpInput(state);
+  for (auto _ : state) {
+    {
+      std::ofstream out(kDumpPath, std::ios::binary | std::ios::trunc);
+      out << v.size() << '\n';
+      for (float x : v) {
+        out << x << ' ';
+      }
+    }
+    std::ifstream in(kDumpPath, std::ios::binary);
+    size_t n = 0;
+    in >> n;
+    s21::vector<float> loaded;
+    for (size_t i = 0; i < n; ++i) {
+      float x;
+      in >> x;
+      loaded.push_back(x);
+    }
+    benchmark::DoNotOptimize(loaded.data());
+  }
+  state.SetBytesProcessed(state.iterations() * v.size() * sizeof(float));
+}
+
+static void BM_DumpBinary(benchmark::State &state) {
+  s21::vector<float> v = DumpInput(state);
+  for (auto _ : state) {
+    int fd = ::open(kDumpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    v.write_to(fd);
+    ::close(fd);
+    fd = ::open(kDumpPath, O_RDONLY);
+    s21::vector<float> loaded;
+    loaded.read_from(fd);
+    ::close(fd);
+    benchmark::DoNotOptimize(loaded.data());
+  }
+  state.SetBytesProcessed(state.iterations() * v.size() * sizeof(float));
+}
+
+// Sums a range(0) MiB vector of floats in a strided order that touches a
+// new 4 KiB page on almost every load, so TLB reach decides the speed.
+template <typename Vector> static void BM_ScanLarge(benchmark::State &state) {
+  const size_t n = static_cast<size_t>(state.range(0)) << 20 >> 2;
+  Vector v;
+  v.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    v.push_back(1.0f);
+  }
+  constexpr size_t stride = 4096 / sizeof(float) + 1;
+  for (auto _ : state) {
+    float sum = 0;
+    for (size_t i = 0, j = 0; i < n; ++i) {
+      sum += v[j];
+      j += stride;
+      if (j >= n) {
+        j -= n;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Push `n` heap-allocated strings, moving each one in.
+template <typename Vector> static void BM_PushStrings(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(std::string(48, 'x'));
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector>
+static void BM_EmplaceStrings(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) {
+      v.emplace_back(48, 'x');
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vector> static void BM_PushInts(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(i);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Sum through operator[]; with the unchecked accessor this should vectorize
+// and match the raw-pointer loop below.
+template <typename Vector> static void BM_IndexSum(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  Vector v;
+  for (int i = 0; i < n; ++i) {
+    v.push_back(i % 7);
+  }
+  for (auto _ : state) {
+    int sum = 0;
+    for (size_t i = 0; i < v.size(); ++i) {
+      sum += v[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(int));
+}
+
+static void BM_RawPointerSum(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  s21::vector<int> v;
+  for (int i = 0; i < n; ++i) {
+    v.push_back(i % 7);
+  }
+  for (auto _ : state) {
+    const int *p = v.data();
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+      sum += p[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(int));
+}
+
+// A record like the tests' Person, stored as an array of structs and as a
+// soa_vector. The scans read only the age, so the AoS loop pulls a whole
+// 40-byte record through the cache per 4-byte field.
+struct BenchPerson {
+  std::string name;
+  int age;
+  bool is_student;
+};
+
+using PersonRows = s21::soa_vector<std::string, int, bool>;
+
+static int PersonAge(int i) { return 18 + (i * 7919) % 60; }
+
+static s21::vector<BenchPerson> PeopleAos(int n) {
+  s21::vector<BenchPerson> people;
+  people.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    people.push_back({"person", PersonAge(i), i % 3 == 0});
+  }
+  return people;
+}
+
+static PersonRows PeopleSoa(int n) {
+  PersonRows people;
+  people.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    people.emplace_back("person", PersonAge(i), i % 3 == 0);
+  }
+  return people;
+}
+
+static void BM_AosSumAges(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  s21::vector<BenchPerson> people = PeopleAos(n);
+  for (auto _ : state) {
+    long sum = 0;
+    for (size_t i = 0; i < people.size(); ++i) {
+      sum += people[i].age;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_SoaSumAges(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  PersonRows people = PeopleSoa(n);
+  for (auto _ : state) {
+    long sum = 0;
+    for (int age : people.column<1>()) {
+      sum += age;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Counts one age: a loop over the structs against s21::simd::count on the
+// age column.
+static void BM_AosCountAge(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  s21::vector<BenchPerson> people = PeopleAos(n);
+  for (auto _ : state) {
+    size_t count = 0;
+    for (size_t i = 0; i < people.size(); ++i) {
+      count += people[i].age == 30;
+    }
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_SoaCountAge(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  PersonRows people = PeopleSoa(n);
+  for (auto _ : state) {
+    std::span<const int> ages = std::as_const(people).column<1>();
+    benchmark::DoNotOptimize(s21::simd::count(ages.data(), ages.size(), 30));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Insert `n` ints at the front half-way point, shifting the tail each time.
+template <typename Vector> static void BM_InsertMiddle(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    for (int i = 0; i < n; ++i) {
+      v.insert(v.begin() + v.size() / 2, i);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Append `n` ints in chunks of 64 through range insert, against a loop of
+// push_back calls over the same chunks.
+template <typename Vector, bool Bulk>
+static void BM_AppendChunks(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  std::vector<int> chunk(64);
+  for (int i = 0; i < 64; ++i) {
+    chunk[i] = i;
+  }
+  for (auto _ : state) {
+    Vector v;
+    for (int done = 0; done < n; done += 64) {
+      if constexpr (Bulk) {
+        v.insert(v.end(), chunk.begin(), chunk.end());
+      } else {
+        for (int value : chunk) {
+          v.push_back(value);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Erase from the middle until empty.
+template <typename Vector> static void BM_EraseMiddle(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Vector v;
+    for (int i = 0; i < n; ++i) {
+      v.push_back(i);
+    }
+    state.ResumeTiming();
+    while (!v.empty()) {
+      v.erase(v.begin() + v.size() / 2);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// reserve() up front, then fill: measures the relocation-free append path.
+template <typename Vector>
+static void BM_ReserveThenPush(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    v.reserve(n);
+    for (int i = 0; i < n; ++i) {
+      v.push_back(i);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Repeated reserve() doubling on a full vector: pure relocation cost.
+template <typename Vector> static void BM_ReserveGrow(benchmark::State &state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Vector v;
+    v.push_back(0);
+    for (size_t cap = 2; cap <= static_cast<size_t>(n); cap *= 2) {
+      while (v.size() < v.capacity()) {
+        v.push_back(1);
+      }
+      v.reserve(cap);
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+BENCHMARK(BM_ShortLivedVector<s21::vector<int, CountingAllocator<int>>>)->DenseRange(1, 8)->Arg(16);
+BENCHMARK(BM_ShortLivedVector<s21::small_vector<int, 8, CountingAllocator<int>>>)->DenseRange(1, 8)->Arg(16);
+
+BENCHMARK(BM_GrowLarge<HeapFloats>)->Arg(1024)->Arg(2048)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GrowLarge<MappedFloats>)->Arg(1024)->Arg(2048)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScanLarge<HeapFloats>)->Arg(1024)->Arg(2048)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ScanLarge<MappedFloats>)->Arg(1024)->Arg(2048)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_DumpElementwise)->Arg(16)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DumpBinary)->Arg(16)->Arg(256)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_PushStrings<s21::vector<std::string>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushStrings<std::vector<std::string>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_EmplaceStrings<s21::vector<std::string>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_EmplaceStrings<std::vector<std::string>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushInts<s21::vector<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_PushInts<std::vector<int>>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_IndexSum<s21::vector<int>>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_IndexSum<std::vector<int>>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_RawPointerSum)->Range(1 << 10, 1 << 22);
+
+BENCHMARK(BM_AosSumAges)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SoaSumAges)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_AosCountAge)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_SoaCountAge)->Range(1 << 10, 1 << 22);
+
+BENCHMARK(BM_AppendChunks<s21::vector<int>, false>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendChunks<s21::vector<int>, true>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendChunks<std::vector<int>, true>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_AppendChunks<s21::vector<int, std::allocator<int>, s21::growth::one_and_half>, true>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_InsertMiddle<s21::vector<int>>)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_InsertMiddle<std::vector<int>>)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_EraseMiddle<s21::vector<int>>)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_EraseMiddle<std::vector<int>>)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_ReserveThenPush<s21::vector<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ReserveThenPush<std::vector<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ReserveGrow<s21::vector<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ReserveGrow<std::vector<int>>)->Range(1 << 10, 1 << 20);
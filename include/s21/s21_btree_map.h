@@ -0,0 +1,987 @@
+#include "s21_map.h"
+#include "s21_vector.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef BTREE_MAP_H
+#define BTREE_MAP_H
+
+namespace s21 {
+// Ordered map backed by a B+ tree. Every element lives in a leaf; leaves
+// hold many slots each and are chained left to right, so a scan walks
+// contiguous memory and a lookup touches one cache-line-aligned node per
+// level instead of one node per comparison. Inner nodes hold only keys and
+// child pointers.
+//
+// Mirrors the s21::map member API. Unlike s21::map, insert and erase may move
+// elements between leaves, so they invalidate iterators, references and
+// pointers to elements.
+template <typename Key, typename T,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = std::less<Key>;
+  using allocator_type = Allocator;
+
+private:
+  // Nodes are sized to four cache lines; the headers are the parent, count
+  // and leaf flag, plus the sibling links in leaves and the spare child
+  // pointer in inner nodes.
+  static constexpr size_type node_bytes = 256;
+  static constexpr size_type leaf_header = 5 * sizeof(void *);
+  static constexpr size_type inner_header = 4 * sizeof(void *);
+
+  static constexpr size_type leaf_capacity =
+      (node_bytes - leaf_header) / sizeof(value_type) > 4
+          ? (node_bytes - leaf_header) / sizeof(value_type)
+          : 4;
+  static constexpr size_type inner_capacity =
+      (node_bytes - inner_header) / (sizeof(Key) + sizeof(void *)) > 4
+          ? (node_bytes - inner_header) / (sizeof(Key) + sizeof(void *))
+          : 4;
+  static constexpr size_type min_leaf = leaf_capacity / 2;
+  static constexpr size_type min_inner = (inner_capacity - 1) / 2;
+
+  struct inner_node;
+
+  struct node_base {
+    inner_node *parent = nullptr;
+    size_type count = 0;
+    bool is_leaf;
+
+    explicit node_base(bool leaf) : is_leaf(leaf) {}
+  };
+
+  struct alignas(64) leaf_node : node_base {
+    leaf_node *prev = nullptr;
+    leaf_node *next = nullptr;
+    alignas(value_type) unsigned char storage[leaf_capacity *
+                                              sizeof(value_type)];
+
+    leaf_node() : node_base(true) {}
+    value_type *slots() noexcept {
+      return std::launder(reinterpret_cast<value_type *>(storage));
+    }
+  };
+
+  struct alignas(64) inner_node : node_base {
+    node_base *children[inner_capacity + 1];
+    alignas(Key) unsigned char storage[inner_capacity * sizeof(Key)];
+
+    inner_node() : node_base(false) {}
+    Key *keys() noexcept {
+      return std::launder(reinterpret_cast<Key *>(storage));
+    }
+  };
+
+  using leaf_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<leaf_node>;
+  using inner_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<inner_node>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using inner_traits = std::allocator_traits<inner_allocator>;
+
+public:
+  class iterator {
+  public:
+    using value_type = std::pair<const Key, T>;
+    using reference = value_type &;
+    using pointer = value_type *;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    iterator() = default;
+
+    reference operator*() const { return leaf->slots()[index]; }
+    pointer operator->() const { return &leaf->slots()[index]; }
+
+    iterator &operator++() {
+      if (++index == leaf->count) {
+        leaf = leaf->next;
+        index = 0;
+      }
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    iterator &operator--() {
+      if (!leaf) {
+        leaf = *last_leaf;
+        index = leaf->count - 1;
+      } else if (index == 0) {
+        leaf = leaf->prev;
+        index = leaf->count - 1;
+      } else {
+        --index;
+      }
+      return *this;
+    }
+
+    iterator operator--(int) {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const {
+      return leaf == other.leaf && index == other.index;
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    friend class btree_map;
+
+    iterator(leaf_node *l, size_type i, leaf_node *const *last)
+        : leaf(l), index(i), last_leaf(last) {}
+
+    leaf_node *leaf = nullptr;
+    size_type index = 0;
+    leaf_node *const *last_leaf = nullptr;
+  };
+
+private:
+  node_base *root = nullptr;
+  leaf_node *first_leaf = nullptr;
+  leaf_node *last_leaf = nullptr;
+  size_type count = 0;
+  [[no_unique_address]] key_compare comp;
+  [[no_unique_address]] leaf_allocator leaf_alloc;
+  [[no_unique_address]] inner_allocator inner_alloc;
+
+public:
+  btree_map() noexcept = default;
+
+  template <typename InputIt> btree_map(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  btree_map(std::initializer_list<value_type> init)
+      : btree_map(init.begin(), init.end()) {}
+
+  // Packs strictly ascending input into full leaves and builds the inner
+  // levels bottom-up in O(n).
+  template <typename ForwardIt>
+  btree_map(sorted_unique_t, ForwardIt first, ForwardIt last) {
+    build_sorted(first, static_cast<size_type>(std::distance(first, last)));
+  }
+
+  btree_map(sorted_unique_t, std::initializer_list<value_type> init)
+      : btree_map(sorted_unique, init.begin(), init.end()) {}
+
+  btree_map(const btree_map &other)
+      : comp(other.comp),
+        leaf_alloc(leaf_traits::select_on_container_copy_construction(
+            other.leaf_alloc)),
+        inner_alloc(inner_traits::select_on_container_copy_construction(
+            other.inner_alloc)) {
+    build_sorted(iterator(other.first_leaf, 0, &other.last_leaf), other.count);
+  }
+
+  btree_map(btree_map &&other) noexcept
+      : root(other.root), first_leaf(other.first_leaf),
+        last_leaf(other.last_leaf), count(other.count),
+        comp(std::move(other.comp)), leaf_alloc(std::move(other.leaf_alloc)),
+        inner_alloc(std::move(other.inner_alloc)) {
+    other.root = nullptr;
+    other.first_leaf = nullptr;
+    other.last_leaf = nullptr;
+    other.count = 0;
+  }
+
+  ~btree_map() { clear(); }
+
+  btree_map &operator=(const btree_map &other) {
+    if (this != &other) {
+      btree_map copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  // Takes `other`'s nodes when the allocator propagates or the two compare
+  // equal; otherwise the nodes must stay with `other`'s allocator, so the
+  // elements are moved into nodes from this map's.
+  btree_map &operator=(btree_map &&other) noexcept(
+      leaf_traits::propagate_on_container_move_assignment::value ||
+      leaf_traits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    comp = std::move(other.comp);
+    if constexpr (leaf_traits::propagate_on_container_move_assignment::value) {
+      leaf_alloc = std::move(other.leaf_alloc);
+      inner_alloc = std::move(other.inner_alloc);
+    } else if (!(leaf_alloc == other.leaf_alloc)) {
+      build_sorted(std::make_move_iterator(other.begin()), other.count);
+      other.clear();
+      return *this;
+    }
+    root = other.root;
+    first_leaf = other.first_leaf;
+    last_leaf = other.last_leaf;
+    count = other.count;
+    other.root = nullptr;
+    other.first_leaf = nullptr;
+    other.last_leaf = nullptr;
+    other.count = 0;
+    return *this;
+  }
+
+  btree_map &operator=(std::initializer_list<value_type> ilist) {
+    clear();
+    for (const auto &item : ilist) {
+      insert(item);
+    }
+    return *this;
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return try_emplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  // Hints carry no information a B+ tree descent can use; accepted for
+  // interface parity with s21::map.
+  iterator insert(iterator, const value_type &value) {
+    return insert(value).first;
+  }
+
+  iterator insert(iterator, value_type &&value) {
+    return insert(std::move(value)).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    if constexpr (sizeof...(Args) == 2 && is_key_first<Args...>) {
+      return try_emplace(std::forward<Args>(args)...);
+    } else {
+      value_type value(std::forward<Args>(args)...);
+      return try_emplace(value.first, std::move(value.second));
+    }
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args &&...args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplace_unique(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return emplace_unique(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    iterator it = find(key);
+    if (it != end()) {
+      it->second = std::forward<M>(obj);
+      return {it, false};
+    }
+    return emplace_unique(key, std::forward<M>(obj));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    iterator it = find(key);
+    if (it != end()) {
+      it->second = std::forward<M>(obj);
+      return {it, false};
+    }
+    return emplace_unique(std::move(key), std::forward<M>(obj));
+  }
+
+  void swap(btree_map &other) noexcept {
+    using std::swap;
+    swap(root, other.root);
+    swap(first_leaf, other.first_leaf);
+    swap(last_leaf, other.last_leaf);
+    swap(count, other.count);
+    swap(comp, other.comp);
+    if constexpr (leaf_traits::propagate_on_container_swap::value) {
+      swap(leaf_alloc, other.leaf_alloc);
+      swap(inner_alloc, other.inner_alloc);
+    }
+  }
+
+  // Moves every element whose key is absent here out of `other`. Elements
+  // cannot be relinked between B+ trees, so their mapped values are moved.
+  void merge(btree_map &other) {
+    if (this == &other)
+      return;
+    vector<Key> moved;
+    for (auto it = other.begin(); it != other.end(); ++it) {
+      if (try_emplace(it->first, std::move(it->second)).second) {
+        moved.push_back(it->first);
+      }
+    }
+    for (size_type i = 0; i < moved.size(); ++i) {
+      other.erase(other.find(moved[i]));
+    }
+  }
+
+  bool contains(const Key &key) const noexcept {
+    if (!root)
+      return false;
+    leaf_node *leaf = find_leaf(key);
+    value_type *slots = leaf->slots();
+    value_type *it = std::partition_point(
+        slots, slots + leaf->count,
+        [&](const value_type &v) { return comp(v.first, key); });
+    return it != slots + leaf->count && !comp(key, it->first);
+  }
+
+  size_type size() const noexcept { return count; }
+  bool empty() const noexcept { return count == 0; }
+
+  void clear() noexcept {
+    if (root) {
+      destroy_subtree(root);
+    }
+    root = nullptr;
+    first_leaf = nullptr;
+    last_leaf = nullptr;
+    count = 0;
+  }
+
+  iterator begin() { return make_iterator(first_leaf, 0); }
+  iterator end() { return make_iterator(nullptr, 0); }
+
+  T &operator[](const Key &key) {
+    iterator it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("Key not found in map");
+    }
+    return it->second;
+  }
+
+  T &at(const Key &key) {
+    iterator it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("Key not found in map");
+    }
+    return it->second;
+  }
+
+  iterator find(const Key &key) {
+    iterator it = lower_bound(key);
+    if (it != end() && !comp(key, it->first)) {
+      return it;
+    }
+    return end();
+  }
+
+  iterator lower_bound(const Key &key) {
+    if (!root)
+      return end();
+    leaf_node *leaf = find_leaf(key);
+    value_type *slots = leaf->slots();
+    size_type i = std::partition_point(slots, slots + leaf->count,
+                                       [&](const value_type &v) {
+                                         return comp(v.first, key);
+                                       }) -
+                  slots;
+    return normalize(leaf, i);
+  }
+
+  iterator upper_bound(const Key &key) {
+    if (!root)
+      return end();
+    leaf_node *leaf = find_leaf(key);
+    value_type *slots = leaf->slots();
+    size_type i = std::partition_point(slots, slots + leaf->count,
+                                       [&](const value_type &v) {
+                                         return !comp(key, v.first);
+                                       }) -
+                  slots;
+    return normalize(leaf, i);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    iterator first = lower_bound(key);
+    iterator last = first;
+    if (last != end() && !comp(key, last->first)) {
+      ++last;
+    }
+    return {first, last};
+  }
+
+  void erase(iterator pos) {
+    if (pos == end())
+      return;
+    leaf_node *leaf = pos.leaf;
+    value_type *slots = leaf->slots();
+    slots[pos.index].~value_type();
+    relocate(slots + pos.index, slots + pos.index + 1,
+             leaf->count - pos.index - 1);
+    --leaf->count;
+    --count;
+    rebalance_leaf(leaf);
+  }
+
+  void print() const {
+    std::cout << "Map contents (in-order):\n";
+    for (leaf_node *leaf = first_leaf; leaf; leaf = leaf->next) {
+      for (size_type i = 0; i < leaf->count; ++i) {
+        std::cout << leaf->slots()[i].first << " = "
+                  << leaf->slots()[i].second << "\n";
+      }
+    }
+    std::cout << "\n";
+  }
+
+private:
+  template <typename First, typename...>
+  static constexpr bool is_key_first =
+      std::is_same_v<std::remove_cvref_t<First>, Key>;
+
+  iterator make_iterator(leaf_node *leaf, size_type index) {
+    return iterator(leaf, index, &last_leaf);
+  }
+
+  // A position one past the last slot of a leaf is the next leaf's first.
+  iterator normalize(leaf_node *leaf, size_type index) {
+    if (index == leaf->count) {
+      return make_iterator(leaf->next, 0);
+    }
+    return make_iterator(leaf, index);
+  }
+
+  // Moves `n` objects from `src` to `dst`; the ranges may overlap. Objects
+  // end their lifetime at `src` and begin it at `dst`.
+  template <typename U> static void relocate(U *dst, U *src, size_type n) {
+    if (n == 0 || dst == src)
+      return;
+    if constexpr (is_trivially_relocatable_v<U>) {
+      std::memmove(static_cast<void *>(dst), static_cast<void *>(src),
+                   n * sizeof(U));
+    } else if (dst < src) {
+      for (size_type i = 0; i < n; ++i) {
+        new (&dst[i]) U(std::move(src[i]));
+        src[i].~U();
+      }
+    } else {
+      for (size_type i = n; i-- > 0;) {
+        new (&dst[i]) U(std::move(src[i]));
+        src[i].~U();
+      }
+    }
+  }
+
+  static inner_node *as_inner(node_base *node) noexcept {
+    return static_cast<inner_node *>(node);
+  }
+  static leaf_node *as_leaf(node_base *node) noexcept {
+    return static_cast<leaf_node *>(node);
+  }
+
+  leaf_node *new_leaf() {
+    leaf_node *leaf = leaf_traits::allocate(leaf_alloc, 1);
+    leaf_traits::construct(leaf_alloc, leaf);
+    return leaf;
+  }
+
+  inner_node *new_inner() {
+    inner_node *inner = inner_traits::allocate(inner_alloc, 1);
+    inner_traits::construct(inner_alloc, inner);
+    return inner;
+  }
+
+  void free_leaf(leaf_node *leaf) noexcept {
+    leaf_traits::destroy(leaf_alloc, leaf);
+    leaf_traits::deallocate(leaf_alloc, leaf, 1);
+  }
+
+  void free_inner(inner_node *inner) noexcept {
+    inner_traits::destroy(inner_alloc, inner);
+    inner_traits::deallocate(inner_alloc, inner, 1);
+  }
+
+  void destroy_subtree(node_base *node) noexcept {
+    if (node->is_leaf) {
+      leaf_node *leaf = as_leaf(node);
+      for (size_type i = 0; i < leaf->count; ++i) {
+        leaf->slots()[i].~value_type();
+      }
+      free_leaf(leaf);
+    } else {
+      inner_node *inner = as_inner(node);
+      for (size_type i = 0; i <= inner->count; ++i) {
+        destroy_subtree(inner->children[i]);
+      }
+      for (size_type i = 0; i < inner->count; ++i) {
+        inner->keys()[i].~Key();
+      }
+      free_inner(inner);
+    }
+  }
+
+  // Descends to the only leaf that may hold `key`.
+  leaf_node *find_leaf(const Key &key) const {
+    node_base *node = root;
+    while (!node->is_leaf) {
+      inner_node *inner = as_inner(node);
+      Key *keys = inner->keys();
+      size_type i = std::partition_point(keys, keys + inner->count,
+                                         [&](const Key &sep) {
+                                           return !comp(key, sep);
+                                         }) -
+                    keys;
+      node = inner->children[i];
+    }
+    return as_leaf(node);
+  }
+
+  static size_type child_index(inner_node *parent, node_base *child) {
+    size_type i = 0;
+    while (parent->children[i] != child) {
+      ++i;
+    }
+    return i;
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(K &&key, Args &&...args) {
+    if (!root) {
+      first_leaf = last_leaf = new_leaf();
+      root = first_leaf;
+    }
+    leaf_node *leaf = find_leaf(key);
+    value_type *slots = leaf->slots();
+    size_type i = std::partition_point(slots, slots + leaf->count,
+                                       [&](const value_type &v) {
+                                         return comp(v.first, key);
+                                       }) -
+                  slots;
+    if (i < leaf->count && !comp(key, slots[i].first)) {
+      return {make_iterator(leaf, i), false};
+    }
+    if (leaf->count == leaf_capacity) {
+      leaf_node *right = split_leaf(leaf);
+      if (i > leaf->count) {
+        i -= leaf->count;
+        leaf = right;
+      }
+      slots = leaf->slots();
+    }
+
+    relocate(slots + i + 1, slots + i, leaf->count - i);
+    try {
+      new (&slots[i]) value_type(
+          std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+          std::forward_as_tuple(std::forward<Args>(args)...));
+    } catch (...) {
+      relocate(slots + i, slots + i + 1, leaf->count - i);
+      throw;
+    }
+    ++leaf->count;
+    ++count;
+    return {make_iterator(leaf, i), true};
+  }
+
+  // Moves the upper half of a full leaf into a new right sibling and
+  // registers the sibling with the parent. Everything that may throw comes
+  // first: the separator is copied, every node the split needs (up to a new
+  // root) is allocated and the upper half is built in the sibling, so on
+  // failure the tree is untouched. What remains only moves inner keys,
+  // which must not throw.
+  leaf_node *split_leaf(leaf_node *leaf) {
+    size_type moved = leaf_capacity / 2;
+    size_type kept = leaf->count - moved;
+    Key sep(leaf->slots()[kept].first);
+    vector<inner_node *> spare;
+    leaf_node *right = nullptr;
+    try {
+      for (size_type n = inners_needed(leaf); n > 0; --n) {
+        spare.push_back(new_inner());
+      }
+      right = new_leaf();
+      transfer(right->slots(), leaf->slots() + kept, moved);
+    } catch (...) {
+      if (right) {
+        free_leaf(right);
+      }
+      for (size_type i = 0; i < spare.size(); ++i) {
+        free_inner(spare[i]);
+      }
+      throw;
+    }
+    right->count = moved;
+    leaf->count = kept;
+
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next) {
+      leaf->next->prev = right;
+    } else {
+      last_leaf = right;
+    }
+    leaf->next = right;
+
+    insert_into_parent(leaf, std::move(sep), right, spare);
+    return right;
+  }
+
+  // Relocates `n` values from `src` to the uninitialized `dst`. Moving a
+  // value copies its const key, so unless the values are trivially
+  // relocatable they are all built at `dst` before any is destroyed at
+  // `src`; if one throws, those built are destroyed and `src` is intact.
+  static void transfer(value_type *dst, value_type *src, size_type n) {
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      relocate(dst, src, n);
+    } else {
+      size_type built = 0;
+      try {
+        for (; built < n; ++built) {
+          new (&dst[built]) value_type(std::move_if_noexcept(src[built]));
+        }
+      } catch (...) {
+        for (size_type i = 0; i < built; ++i) {
+          dst[i].~value_type();
+        }
+        throw;
+      }
+      for (size_type i = 0; i < n; ++i) {
+        src[i].~value_type();
+      }
+    }
+  }
+
+  // Inner nodes a split of `leaf` allocates: a sibling for every full
+  // ancestor it climbs through, and a new root if it climbs past the root.
+  static size_type inners_needed(const leaf_node *leaf) noexcept {
+    size_type needed = 0;
+    for (inner_node *parent = leaf->parent; parent; parent = parent->parent) {
+      if (parent->count < inner_capacity) {
+        return needed;
+      }
+      ++needed;
+    }
+    return needed + 1;
+  }
+
+  void insert_into_inner(inner_node *inner, size_type pos, Key &&sep,
+                         node_base *child) {
+    Key *keys = inner->keys();
+    new (&keys[inner->count]) Key(std::move(sep));
+    std::rotate(keys + pos, keys + inner->count, keys + inner->count + 1);
+    std::memmove(inner->children + pos + 2, inner->children + pos + 1,
+                 (inner->count - pos) * sizeof(node_base *));
+    inner->children[pos + 1] = child;
+    child->parent = inner;
+    ++inner->count;
+  }
+
+  // Links `right` as the sibling after `left`, separated by `sep`; splits
+  // full ancestors on the way up, taking their new siblings and any new
+  // root from `spare`.
+  void insert_into_parent(node_base *left, Key &&sep, node_base *right,
+                          vector<inner_node *> &spare) {
+    inner_node *parent = left->parent;
+    if (!parent) {
+      inner_node *new_root = spare.back();
+      spare.pop_back();
+      new (&new_root->keys()[0]) Key(std::move(sep));
+      new_root->children[0] = left;
+      new_root->children[1] = right;
+      new_root->count = 1;
+      left->parent = new_root;
+      right->parent = new_root;
+      root = new_root;
+      return;
+    }
+
+    size_type pos = child_index(parent, left);
+    if (parent->count < inner_capacity) {
+      insert_into_inner(parent, pos, std::move(sep), right);
+      return;
+    }
+
+    size_type mid = inner_capacity / 2;
+    inner_node *sibling = spare.back();
+    spare.pop_back();
+    Key *keys = parent->keys();
+    Key up(std::move(keys[mid]));
+    keys[mid].~Key();
+    size_type moved = inner_capacity - mid - 1;
+    relocate(sibling->keys(), keys + mid + 1, moved);
+    std::memcpy(sibling->children, parent->children + mid + 1,
+                (moved + 1) * sizeof(node_base *));
+    for (size_type i = 0; i <= moved; ++i) {
+      sibling->children[i]->parent = sibling;
+    }
+    sibling->count = moved;
+    parent->count = mid;
+
+    if (pos <= mid) {
+      insert_into_inner(parent, pos, std::move(sep), right);
+    } else {
+      insert_into_inner(sibling, pos - mid - 1, std::move(sep), right);
+    }
+    insert_into_parent(parent, std::move(up), sibling, spare);
+  }
+
+  // Drops separator `k` and the child to its right from `inner`.
+  static void remove_from_inner(inner_node *inner, size_type k) noexcept {
+    Key *keys = inner->keys();
+    keys[k].~Key();
+    relocate(keys + k, keys + k + 1, inner->count - k - 1);
+    std::memmove(inner->children + k + 1, inner->children + k + 2,
+                 (inner->count - k - 1) * sizeof(node_base *));
+    --inner->count;
+  }
+
+  void rebalance_leaf(leaf_node *leaf) {
+    if (leaf == root) {
+      if (leaf->count == 0) {
+        free_leaf(leaf);
+        root = nullptr;
+        first_leaf = nullptr;
+        last_leaf = nullptr;
+      }
+      return;
+    }
+    if (leaf->count >= min_leaf)
+      return;
+
+    inner_node *parent = leaf->parent;
+    size_type i = child_index(parent, leaf);
+    leaf_node *left = i > 0 ? as_leaf(parent->children[i - 1]) : nullptr;
+    leaf_node *right =
+        i < parent->count ? as_leaf(parent->children[i + 1]) : nullptr;
+
+    if (left && left->count > min_leaf) {
+      relocate(leaf->slots() + 1, leaf->slots(), leaf->count);
+      relocate(leaf->slots(), left->slots() + left->count - 1, 1);
+      --left->count;
+      ++leaf->count;
+      parent->keys()[i - 1] = leaf->slots()[0].first;
+      return;
+    }
+    if (right && right->count > min_leaf) {
+      relocate(leaf->slots() + leaf->count, right->slots(), 1);
+      relocate(right->slots(), right->slots() + 1, right->count - 1);
+      --right->count;
+      ++leaf->count;
+      parent->keys()[i] = right->slots()[0].first;
+      return;
+    }
+
+    if (left) {
+      merge_leaves(left, leaf, parent, i - 1);
+    } else {
+      merge_leaves(leaf, right, parent, i);
+    }
+    rebalance_inner(parent);
+  }
+
+  void merge_leaves(leaf_node *left, leaf_node *right, inner_node *parent,
+                    size_type k) {
+    relocate(left->slots() + left->count, right->slots(), right->count);
+    left->count += right->count;
+    right->count = 0;
+    left->next = right->next;
+    if (right->next) {
+      right->next->prev = left;
+    } else {
+      last_leaf = left;
+    }
+    remove_from_inner(parent, k);
+    free_leaf(right);
+  }
+
+  void rebalance_inner(inner_node *inner) {
+    if (inner == root) {
+      if (inner->count == 0) {
+        root = inner->children[0];
+        root->parent = nullptr;
+        free_inner(inner);
+      }
+      return;
+    }
+    if (inner->count >= min_inner)
+      return;
+
+    inner_node *parent = inner->parent;
+    size_type i = child_index(parent, inner);
+    Key *sep = parent->keys();
+    inner_node *left = i > 0 ? as_inner(parent->children[i - 1]) : nullptr;
+    inner_node *right =
+        i < parent->count ? as_inner(parent->children[i + 1]) : nullptr;
+
+    if (left && left->count > min_inner) {
+      Key *keys = inner->keys();
+      relocate(keys + 1, keys, inner->count);
+      new (&keys[0]) Key(std::move(sep[i - 1]));
+      std::memmove(inner->children + 1, inner->children,
+                   (inner->count + 1) * sizeof(node_base *));
+      inner->children[0] = left->children[left->count];
+      inner->children[0]->parent = inner;
+      sep[i - 1] = std::move(left->keys()[left->count - 1]);
+      left->keys()[left->count - 1].~Key();
+      --left->count;
+      ++inner->count;
+      return;
+    }
+    if (right && right->count > min_inner) {
+      new (&inner->keys()[inner->count]) Key(std::move(sep[i]));
+      inner->children[inner->count + 1] = right->children[0];
+      inner->children[inner->count + 1]->parent = inner;
+      sep[i] = std::move(right->keys()[0]);
+      right->keys()[0].~Key();
+      relocate(right->keys(), right->keys() + 1, right->count - 1);
+      std::memmove(right->children, right->children + 1,
+                   right->count * sizeof(node_base *));
+      --right->count;
+      ++inner->count;
+      return;
+    }
+
+    if (left) {
+      merge_inners(left, inner, parent, i - 1);
+    } else {
+      merge_inners(inner, right, parent, i);
+    }
+    rebalance_inner(parent);
+  }
+
+  void merge_inners(inner_node *left, inner_node *right, inner_node *parent,
+                    size_type k) {
+    Key *keys = left->keys();
+    new (&keys[left->count]) Key(parent->keys()[k]);
+    relocate(keys + left->count + 1, right->keys(), right->count);
+    std::memcpy(left->children + left->count + 1, right->children,
+                (right->count + 1) * sizeof(node_base *));
+    for (size_type i = 0; i <= right->count; ++i) {
+      right->children[i]->parent = left;
+    }
+    left->count += right->count + 1;
+    right->count = 0;
+    remove_from_inner(parent, k);
+    free_inner(right);
+  }
+
+  // Builds the tree from the `n` ascending values starting at `first`.
+  // Values are spread evenly over the fewest leaves that hold them, and
+  // children evenly over the fewest inner nodes, so every node but a lone
+  // root is at least half full.
+  template <typename ForwardIt> void build_sorted(ForwardIt first, size_type n) {
+    if (n == 0)
+      return;
+    size_type leaves = (n + leaf_capacity - 1) / leaf_capacity;
+    vector<node_base *> level;
+    vector<const Key *> firsts;
+    // A tree has fewer inner nodes than leaves, so this never reallocates
+    // and the cleanup below can rely on it.
+    vector<inner_node *> inners;
+    inners.reserve(leaves);
+    try {
+      level.reserve(leaves);
+      firsts.reserve(leaves);
+      leaf_node *prev = nullptr;
+      for (size_type l = 0; l < leaves; ++l) {
+        leaf_node *leaf = new_leaf();
+        level.push_back(leaf);
+        leaf->prev = prev;
+        if (prev) {
+          prev->next = leaf;
+        } else {
+          first_leaf = leaf;
+        }
+        last_leaf = leaf;
+        prev = leaf;
+        size_type take = n / leaves + (l < n % leaves ? 1 : 0);
+        for (size_type i = 0; i < take; ++i) {
+          new (&leaf->slots()[i]) value_type(*first);
+          ++first;
+          ++leaf->count;
+          ++count;
+        }
+        firsts.push_back(&leaf->slots()[0].first);
+      }
+
+      while (level.size() > 1) {
+        size_type m = level.size();
+        size_type parents = (m + inner_capacity) / (inner_capacity + 1);
+        vector<node_base *> upper;
+        vector<const Key *> upper_firsts;
+        upper.reserve(parents);
+        upper_firsts.reserve(parents);
+        size_type c = 0;
+        for (size_type p = 0; p < parents; ++p) {
+          inner_node *inner = new_inner();
+          inners.push_back(inner);
+          upper.push_back(inner);
+          upper_firsts.push_back(firsts[c]);
+          size_type take = m / parents + (p < m % parents ? 1 : 0);
+          for (size_type j = 0; j < take; ++j, ++c) {
+            if (j > 0) {
+              new (&inner->keys()[j - 1]) Key(*firsts[c]);
+              inner->count = j;
+            }
+            inner->children[j] = level[c];
+            level[c]->parent = inner;
+          }
+        }
+        level.swap(upper);
+        firsts.swap(upper_firsts);
+      }
+      root = level[0];
+    } catch (...) {
+      for (size_type i = 0; i < inners.size(); ++i) {
+        for (size_type k = 0; k < inners[i]->count; ++k) {
+          inners[i]->keys()[k].~Key();
+        }
+        free_inner(inners[i]);
+      }
+      for (leaf_node *leaf = first_leaf; leaf;) {
+        leaf_node *following = leaf->next;
+        for (size_type i = 0; i < leaf->count; ++i) {
+          leaf->slots()[i].~value_type();
+        }
+        free_leaf(leaf);
+        leaf = following;
+      }
+      first_leaf = last_leaf = nullptr;
+      count = 0;
+      throw;
+    }
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,13 @@
+#include <cstddef>
+
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+namespace s21 {
+// Alignment that keeps data written by different threads on different
+// cache lines. Current x86 cores prefetch lines in adjacent pairs and
+// Apple's ARM cores use 128-byte lines, so 64 is not enough for either.
+inline constexpr std::size_t cache_line_size = 128;
+}
+
+#endif
@@ -0,0 +1,239 @@
+#include "s21_cache_line.h"
+#include "s21_flat_map.h"
+#include "s21_map.h"
+#include "s21_vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+
+#ifndef CONCURRENT_MAP_H
+#define CONCURRENT_MAP_H
+
+namespace s21 {
+// Ordered map that many threads may read and write at once. Keys are
+// hash-partitioned across independent s21::map shards, each behind its own
+// reader-writer lock, so operations on different shards never wait for each
+// other and readers of one shard only wait for its writers.
+//
+// Nothing hands out references into a shard: lookups return copies and
+// in-place changes go through update(). Ordered traversal works on a
+// snapshot taken with every shard read-locked at once, so it sees the map
+// as it was at a single moment.
+//
+// A seqlock was not used because readers would walk tree nodes that a
+// concurrent erase may free.
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class concurrent_map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using snapshot_type = flat_map<Key, T>;
+
+private:
+  // Two shard locks never share a cache line.
+  struct alignas(cache_line_size) shard {
+    mutable std::shared_mutex mutex;
+    map<Key, T> data;
+  };
+
+  std::unique_ptr<shard[]> shards_;
+  size_type shard_bits_ = 0;
+  [[no_unique_address]] hasher hash_;
+
+  shard &shard_for(const Key &key) const {
+    if (shard_bits_ == 0) {
+      return shards_[0];
+    }
+    std::uint64_t h =
+        static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return shards_[h >> (64 - shard_bits_)];
+  }
+
+public:
+  // The shard count is rounded up to a power of two; a few times the number
+  // of cores keeps two busy threads from often landing on the same shard.
+  explicit concurrent_map(size_type shard_count = 64) {
+    while ((size_type{1} << shard_bits_) < shard_count) {
+      ++shard_bits_;
+    }
+    shards_ = std::make_unique<shard[]>(size_type{1} << shard_bits_);
+  }
+
+  concurrent_map(const concurrent_map &) = delete;
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+  size_type shard_count() const noexcept {
+    return size_type{1} << shard_bits_;
+  }
+
+  // Returns a copy of the mapped value, or nothing when the key is absent.
+  std::optional<T> find(const Key &key) const {
+    shard &s = shard_for(key);
+    std::shared_lock lock(s.mutex);
+    auto it = s.data.find(key);
+    if (it == s.data.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  bool contains(const Key &key) const {
+    shard &s = shard_for(key);
+    std::shared_lock lock(s.mutex);
+    return s.data.contains(key);
+  }
+
+  T at(const Key &key) const {
+    std::optional<T> value = find(key);
+    if (!value) {
+      throw std::out_of_range("Key not found in map");
+    }
+    return std::move(*value);
+  }
+
+  // Each returns true when the key was absent and the element was added.
+  bool insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  bool insert(const Key &key, const T &obj) { return try_emplace(key, obj); }
+
+  template <typename... Args>
+  bool try_emplace(const Key &key, Args &&...args) {
+    shard &s = shard_for(key);
+    std::unique_lock lock(s.mutex);
+    return s.data.try_emplace(key, std::forward<Args>(args)...).second;
+  }
+
+  template <typename M> bool insert_or_assign(const Key &key, M &&obj) {
+    shard &s = shard_for(key);
+    std::unique_lock lock(s.mutex);
+    return s.data.insert_or_assign(key, std::forward<M>(obj)).second;
+  }
+
+  // Calls `fn(T&)` on the mapped value while holding the shard's write
+  // lock; returns false when the key is absent. `fn` must not call back
+  // into this map.
+  template <typename F> bool update(const Key &key, F &&fn) {
+    shard &s = shard_for(key);
+    std::unique_lock lock(s.mutex);
+    auto it = s.data.find(key);
+    if (it == s.data.end()) {
+      return false;
+    }
+    std::forward<F>(fn)(it->second);
+    return true;
+  }
+
+  // Returns the number of elements removed (0 or 1).
+  size_type erase(const Key &key) {
+    shard &s = shard_for(key);
+    std::unique_lock lock(s.mutex);
+    auto it = s.data.find(key);
+    if (it == s.data.end()) {
+      return 0;
+    }
+    s.data.erase(it);
+    return 1;
+  }
+
+  // Sums the shards one at a time, so under concurrent writes the result
+  // may match no single moment.
+  size_type size() const {
+    size_type total = 0;
+    for (size_type i = 0; i < shard_count(); ++i) {
+      std::shared_lock lock(shards_[i].mutex);
+      total += shards_[i].data.size();
+    }
+    return total;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    for (size_type i = 0; i < shard_count(); ++i) {
+      std::unique_lock lock(shards_[i].mutex);
+      shards_[i].data.clear();
+    }
+  }
+
+  // Copies every shard while all of them are read-locked, then merges the
+  // copies by key outside the locks. Writers wait only for the copy.
+  snapshot_type snapshot() const {
+    size_type n = shard_count();
+    vector<map<Key, T>> copies;
+    copies.reserve(n);
+    {
+      vector<std::shared_lock<std::shared_mutex>> locks;
+      locks.reserve(n);
+      for (size_type i = 0; i < n; ++i) {
+        locks.emplace_back(shards_[i].mutex);
+      }
+      for (size_type i = 0; i < n; ++i) {
+        copies.emplace_back(shards_[i].data);
+      }
+    }
+    return merge_shards(copies);
+  }
+
+  // Calls `fn(const Key&, const T&)` for every element in key order, over a
+  // snapshot.
+  template <typename F> void for_each(F &&fn) const {
+    snapshot_type snap = snapshot();
+    for (auto it = snap.begin(); it != snap.end(); ++it) {
+      fn(it->first, std::as_const(it->second));
+    }
+  }
+
+private:
+  // k-way merge of the sorted shard copies through a min-heap of shard
+  // indices, ordered by each shard's current key. Hash partitioning keeps
+  // keys unique across shards.
+  static snapshot_type merge_shards(vector<map<Key, T>> &copies) {
+    using cursor = decltype(copies[0].begin());
+    vector<cursor> cursors;
+    vector<size_type> heap;
+    cursors.reserve(copies.size());
+    size_type total = 0;
+    for (size_type i = 0; i < copies.size(); ++i) {
+      total += copies[i].size();
+      cursors.emplace_back(copies[i].begin());
+      if (!copies[i].empty()) {
+        heap.push_back(i);
+      }
+    }
+    auto later = [&cursors](size_type a, size_type b) {
+      return cursors[b]->first < cursors[a]->first;
+    };
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    vector<Key> keys;
+    vector<T> values;
+    keys.reserve(total);
+    values.reserve(total);
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), later);
+      size_type top = heap[heap.size() - 1];
+      keys.push_back(cursors[top]->first);
+      values.push_back(std::move(cursors[top]->second));
+      if (++cursors[top] == copies[top].end()) {
+        heap.pop_back();
+      } else {
+        std::push_heap(heap.begin(), heap.end(), later);
+      }
+    }
+    return snapshot_type(sorted_unique, std::move(keys), std::move(values));
+  }
+};
+
+}
+
+#endif
@@ -1,8 +1,21 @@
 #ifndef S21_CONTAINERS_H
 #define S21_CONTAINERS_H
 
+#include "s21_btree_map.h"
+#include "s21_cache_line.h"
+#include "s21_concurrent_map.h"
+#include "s21_flat_map.h"
 #include "s21_map.h"
+#include "s21_mmap_allocator.h"
+#include "s21_mpmc_queue.h"
+#include "s21_parallel.h"
 #include "s21_queue.h"
+#include "s21_ring_buffer.h"
+#include "s21_simd.h"
+#include "s21_small_vector.h"
+#include "s21_soa_vector.h"
+#include "s21_spsc_queue.h"
+#include "s21_unordered_map.h"
 #include "s21_vector.h"
 #include <stdexcept>
 
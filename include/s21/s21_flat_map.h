@@ -0,0 +1,434 @@
+#include "s21_map.h"
+#include "s21_vector.h"
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+namespace s21 {
+// Ordered map stored as two parallel sorted arrays, one of keys and one of
+// mapped values. Lookups binary-search the key array alone, so they touch
+// only keys, and iteration walks both arrays front to back.
+//
+// Built for tables that are filled once and then queried: the range
+// constructor sorts and deduplicates in O(n log n), while a single insert or
+// erase shifts the arrays in O(n). Mirrors the s21::map member API; insert
+// and erase invalidate iterators.
+template <typename Key, typename T> class flat_map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using size_type = std::size_t;
+  using key_compare = std::less<Key>;
+  using key_container_type = vector<Key>;
+  using mapped_container_type = vector<T>;
+
+  // Elements are not stored as pairs, so dereferencing yields a pair of
+  // references into the two arrays.
+  class iterator {
+  public:
+    using value_type = std::pair<Key, T>;
+    using reference = std::pair<const Key &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    struct pointer {
+      reference ref;
+      reference *operator->() noexcept { return &ref; }
+    };
+
+    iterator() = default;
+
+    reference operator*() const { return {*key, *value}; }
+    pointer operator->() const { return {**this}; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    iterator &operator++() {
+      ++key;
+      ++value;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    iterator &operator--() {
+      --key;
+      --value;
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    iterator &operator+=(difference_type n) {
+      key += n;
+      value += n;
+      return *this;
+    }
+    iterator &operator-=(difference_type n) { return *this += -n; }
+    friend iterator operator+(iterator it, difference_type n) {
+      return it += n;
+    }
+    friend iterator operator+(difference_type n, iterator it) {
+      return it += n;
+    }
+    friend iterator operator-(iterator it, difference_type n) {
+      return it -= n;
+    }
+    friend difference_type operator-(const iterator &a, const iterator &b) {
+      return a.key - b.key;
+    }
+
+    bool operator==(const iterator &other) const { return key == other.key; }
+    std::strong_ordering operator<=>(const iterator &other) const {
+      return key <=> other.key;
+    }
+
+  private:
+    friend class flat_map;
+
+    iterator(const Key *k, T *v) : key(k), value(v) {}
+
+    const Key *key = nullptr;
+    T *value = nullptr;
+  };
+
+private:
+  key_container_type keys_;
+  mapped_container_type values_;
+  [[no_unique_address]] key_compare comp;
+
+public:
+  flat_map() noexcept = default;
+
+  // Sorts the input and keeps the first of any equal keys, as inserting the
+  // elements one by one would.
+  template <typename InputIt> flat_map(InputIt first, InputIt last) {
+    vector<value_type> items;
+    for (; first != last; ++first) {
+      const auto &item = *first;
+      items.emplace_back(item.first, item.second);
+    }
+    std::stable_sort(items.begin(), items.end(),
+                     [this](const value_type &a, const value_type &b) {
+                       return comp(a.first, b.first);
+                     });
+    reserve(items.size());
+    for (size_type i = 0; i < items.size(); ++i) {
+      if (i == 0 || comp(items[i - 1].first, items[i].first)) {
+        keys_.push_back(std::move(items[i].first));
+        values_.push_back(std::move(items[i].second));
+      }
+    }
+  }
+
+  flat_map(std::initializer_list<std::pair<const Key, T>> init)
+      : flat_map(init.begin(), init.end()) {}
+
+  // Takes strictly ascending input as is, in O(n).
+  template <typename InputIt>
+  flat_map(sorted_unique_t, InputIt first, InputIt last) {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<
+                                        InputIt>::iterator_category>) {
+      reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      const auto &item = *first;
+      keys_.push_back(item.first);
+      values_.push_back(item.second);
+    }
+  }
+
+  flat_map(sorted_unique_t, std::initializer_list<std::pair<const Key, T>> init)
+      : flat_map(sorted_unique, init.begin(), init.end()) {}
+
+  // Adopts already sorted, duplicate-free key and value arrays.
+  flat_map(sorted_unique_t, key_container_type keys,
+           mapped_container_type values) {
+    if (keys.size() != values.size()) {
+      throw std::invalid_argument(
+          "Flat map. Key and value arrays differ in size.");
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+  }
+
+  flat_map(const flat_map &other) = default;
+
+  flat_map(flat_map &&other) noexcept
+      : keys_(std::move(other.keys_)), values_(std::move(other.values_)) {}
+
+  flat_map &operator=(const flat_map &other) {
+    if (this != &other) {
+      flat_map copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  flat_map &operator=(flat_map &&other) noexcept {
+    if (this != &other) {
+      flat_map moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  flat_map &operator=(std::initializer_list<std::pair<const Key, T>> ilist) {
+    flat_map built(ilist);
+    swap(built);
+    return *this;
+  }
+
+  std::pair<iterator, bool> insert(const std::pair<const Key, T> &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<const Key, T> &&value) {
+    return try_emplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  iterator insert(iterator, const std::pair<const Key, T> &value) {
+    return insert(value).first;
+  }
+
+  iterator insert(iterator, std::pair<const Key, T> &&value) {
+    return insert(std::move(value)).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    if constexpr (sizeof...(Args) == 2 && is_key_first<Args...>) {
+      return try_emplace(std::forward<Args>(args)...);
+    } else {
+      value_type value(std::forward<Args>(args)...);
+      return try_emplace(std::move(value.first), std::move(value.second));
+    }
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(iterator, Args &&...args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplace_unique(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return emplace_unique(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    size_type i = lower_bound_index(key);
+    if (i < keys_.size() && !comp(key, keys_[i])) {
+      values_[i] = std::forward<M>(obj);
+      return {make_iterator(i), false};
+    }
+    return {insert_at(i, key, std::forward<M>(obj)), true};
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    size_type i = lower_bound_index(key);
+    if (i < keys_.size() && !comp(key, keys_[i])) {
+      values_[i] = std::forward<M>(obj);
+      return {make_iterator(i), false};
+    }
+    return {insert_at(i, std::move(key), std::forward<M>(obj)), true};
+  }
+
+  // Merges both sorted arrays in one linear pass. Keys already present here
+  // stay in `other`.
+  void merge(flat_map &other) {
+    if (this == &other)
+      return;
+    key_container_type keys;
+    mapped_container_type values;
+    key_container_type left_keys;
+    mapped_container_type left_values;
+    keys.reserve(keys_.size() + other.keys_.size());
+    values.reserve(keys_.size() + other.keys_.size());
+    size_type i = 0;
+    size_type j = 0;
+    while (i < keys_.size() || j < other.keys_.size()) {
+      if (j == other.keys_.size() ||
+          (i < keys_.size() && comp(keys_[i], other.keys_[j]))) {
+        keys.push_back(std::move(keys_[i]));
+        values.push_back(std::move(values_[i]));
+        ++i;
+      } else if (i == keys_.size() || comp(other.keys_[j], keys_[i])) {
+        keys.push_back(std::move(other.keys_[j]));
+        values.push_back(std::move(other.values_[j]));
+        ++j;
+      } else {
+        left_keys.push_back(std::move(other.keys_[j]));
+        left_values.push_back(std::move(other.values_[j]));
+        ++j;
+      }
+    }
+    keys_.swap(keys);
+    values_.swap(values);
+    other.keys_.swap(left_keys);
+    other.values_.swap(left_values);
+  }
+
+  void swap(flat_map &other) noexcept {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+  bool contains(const Key &key) const {
+    size_type i = lower_bound_index(key);
+    return i < keys_.size() && !comp(key, keys_[i]);
+  }
+
+  size_type size() const noexcept { return keys_.size(); }
+  bool empty() const noexcept { return keys_.size() == 0; }
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+
+  const key_container_type &keys() const noexcept { return keys_; }
+  const mapped_container_type &values() const noexcept { return values_; }
+
+  iterator begin() { return make_iterator(0); }
+  iterator end() { return make_iterator(keys_.size()); }
+
+  T &operator[](const Key &key) { return at(key); }
+
+  T &at(const Key &key) {
+    size_type i = lower_bound_index(key);
+    if (i == keys_.size() || comp(key, keys_[i])) {
+      throw std::out_of_range("Key not found in map");
+    }
+    return values_[i];
+  }
+
+  iterator find(const Key &key) {
+    size_type i = lower_bound_index(key);
+    if (i < keys_.size() && !comp(key, keys_[i])) {
+      return make_iterator(i);
+    }
+    return end();
+  }
+
+  iterator lower_bound(const Key &key) {
+    return make_iterator(lower_bound_index(key));
+  }
+
+  iterator upper_bound(const Key &key) {
+    size_type i = lower_bound_index(key);
+    if (i < keys_.size() && !comp(key, keys_[i])) {
+      ++i;
+    }
+    return make_iterator(i);
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    iterator first = lower_bound(key);
+    iterator last = first;
+    if (last != end() && !comp(key, last->first)) {
+      ++last;
+    }
+    return {first, last};
+  }
+
+  void erase(iterator pos) {
+    if (pos == end())
+      return;
+    size_type i = static_cast<size_type>(pos - begin());
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+  }
+
+  void print() const {
+    std::cout << "Map contents (in-order):\n";
+    for (size_type i = 0; i < keys_.size(); ++i) {
+      std::cout << keys_[i] << " = " << values_[i] << "\n";
+    }
+    std::cout << "\n";
+  }
+
+private:
+  template <typename First, typename...>
+  static constexpr bool is_key_first =
+      std::is_same_v<std::remove_cvref_t<First>, Key>;
+
+  iterator make_iterator(size_type i) {
+    return iterator(keys_.data() + i, values_.data() + i);
+  }
+
+  // Branchless binary search: the range halves every step and the only
+  // data-dependent choice is a conditional move, so there are no branch
+  // mispredictions to pay for on random keys.
+  size_type lower_bound_index(const Key &key) const {
+    size_type n = keys_.size();
+    if (n == 0)
+      return 0;
+    const Key *base = keys_.data();
+    while (n > 1) {
+      size_type half = n / 2;
+      base = comp(base[half], key) ? base + half : base;
+      n -= half;
+    }
+    return static_cast<size_type>(base - keys_.data()) + comp(*base, key);
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(K &&key, Args &&...args) {
+    size_type i = lower_bound_index(key);
+    if (i < keys_.size() && !comp(key, keys_[i])) {
+      return {make_iterator(i), false};
+    }
+    return {insert_at(i, std::forward<K>(key), std::forward<Args>(args)...),
+            true};
+  }
+
+  // The value is built first, since the arguments may refer to an element
+  // about to be shifted; a failed key insert then leaves both arrays as they
+  // were.
+  template <typename K, typename... Args>
+  iterator insert_at(size_type i, K &&key, Args &&...args) {
+    T value(std::forward<Args>(args)...);
+    values_.insert(values_.begin() + i, std::move(value));
+    try {
+      keys_.insert(keys_.begin() + i, Key(std::forward<K>(key)));
+    } catch (...) {
+      values_.erase(values_.begin() + i);
+      throw;
+    }
+    return make_iterator(i);
+  }
+};
+
+}
+
+#endif
@@ -1,17 +1,32 @@
+#include "s21_map_snapshot.h"
+#include "s21_pool_allocator.h"
 #include <iostream>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #ifndef MAP_H
 #define MAP_H
 
 namespace s21 {
-template <typename Key, typename T> class map {
+// Tag for constructors whose input is already sorted by key with no
+// duplicates.
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+template <typename Key, typename T,
+          typename Allocator = pool_allocator<std::pair<const Key, T>>>
+class map {
 public:
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const Key, T>;
   using size_type = std::size_t;
   using key_compare = std::less<Key>;
-  using allocator_type = std::allocator<value_type>;
+  using allocator_type = Allocator;
 
 private:
   struct Node {
@@ -21,22 +36,25 @@ private:
     Node *parent;
     bool is_black;
 
-    Node(const value_type &val, Node *p = nullptr, bool black = false)
-        : data(val), parent(p), left(nullptr), right(nullptr), is_black(black) {
-    }
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : data(std::forward<Args>(args)...), left(nullptr), right(nullptr),
+          parent(nullptr), is_black(false) {}
   };
 
   template <typename K, typename H> class iterator {
-    using Node = typename map<K, H>::Node;
-
   public:
     Node *current;
     using value_type = std::pair<const K, H>;
     using reference = value_type &;
     using pointer = value_type *;
+    using difference_type = std::ptrdiff_t;
     using iterator_category = std::bidirectional_iterator_tag;
 
-    explicit iterator(Node *node = nullptr) : current(node) {}
+    // `root` points at the owning map's root slot, so that end() can be
+    // decremented to the last element.
+    explicit iterator(Node *node = nullptr, Node *const *root = nullptr)
+        : current(node), tree_root(root) {}
 
     reference operator*() const { return current->data; }
     pointer operator->() const { return &current->data; }
@@ -63,27 +81,127 @@ private:
       return tmp;
     }
 
+    iterator &operator--() {
+      if (!current) {
+        current = tree_root ? *tree_root : nullptr;
+        while (current && current->right)
+          current = current->right;
+      } else if (current->left) {
+        current = current->left;
+        while (current->right)
+          current = current->right;
+      } else {
+        Node *p = current->parent;
+        while (p && current == p->left) {
+          current = p;
+          p = p->parent;
+        }
+        current = p;
+      }
+      return *this;
+    }
+
+    iterator operator--(int) {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
     bool operator==(const iterator &other) const {
       return current == other.current;
     }
     bool operator!=(const iterator &other) const {
       return current != other.current;
     }
+
+  private:
+    Node *const *tree_root;
   };
 
-  using node_allocator = std::allocator<Node>;
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
   using alloc_traits = std::allocator_traits<node_allocator>;
 
+public:
+  // Owns one node detached from a map (C++17 node handle). Keeps a copy of
+  // the map's node allocator, so a pooled node stays valid after the map
+  // that produced it is gone.
+  class node_type {
+  public:
+    using key_type = Key;
+    using mapped_type = T;
+    using allocator_type = Allocator;
+
+    node_type() noexcept = default;
+    node_type(node_type &&other) noexcept
+        : node(other.node), alloc(std::move(other.alloc)) {
+      other.node = nullptr;
+    }
+    node_type &operator=(node_type &&other) noexcept {
+      if (this != &other) {
+        reset();
+        node = other.node;
+        alloc = std::move(other.alloc);
+        other.node = nullptr;
+      }
+      return *this;
+    }
+    ~node_type() { reset(); }
+
+    bool empty() const noexcept { return node == nullptr; }
+    explicit operator bool() const noexcept { return node != nullptr; }
+
+    const key_type &key() const { return node->data.first; }
+    mapped_type &mapped() const { return node->data.second; }
+
+    void swap(node_type &other) noexcept {
+      using std::swap;
+      swap(node, other.node);
+      swap(alloc, other.alloc);
+    }
+
+  private:
+    friend class map;
+
+    node_type(Node *n, const node_allocator &a) : node(n), alloc(a) {}
+
+    Node *release() noexcept {
+      Node *n = node;
+      node = nullptr;
+      return n;
+    }
+
+    void reset() noexcept {
+      if (node) {
+        alloc_traits::destroy(alloc, node);
+        alloc_traits::deallocate(alloc, node, 1);
+        node = nullptr;
+      }
+    }
+
+    Node *node = nullptr;
+    [[no_unique_address]] node_allocator alloc;
+  };
+
+  struct insert_return_type {
+    iterator<Key, T> position;
+    bool inserted;
+    node_type node;
+  };
+
+private:
+
   Node *root;
   size_type count;
   [[no_unique_address]] key_compare comp;
   [[no_unique_address]] node_allocator alloc;
 
-  Node *create_node(const value_type &val, Node *parent = nullptr,
-                    bool black = false) {
+  // Allocates an unlinked red node whose value is built from `args`.
+  template <typename... Args> Node *create_node(Args &&...args) {
     Node *node = alloc_traits::allocate(alloc, 1);
     try {
-      alloc_traits::construct(alloc, node, val, parent, black);
+      alloc_traits::construct(alloc, node, std::in_place,
+                              std::forward<Args>(args)...);
       return node;
     } catch (...) {
       alloc_traits::deallocate(alloc, node, 1);
@@ -96,19 +214,82 @@ private:
     alloc_traits::deallocate(alloc, node, 1);
   }
 
-  void clear_recursive(Node *node) noexcept {
-    if (node) {
-      clear_recursive(node->left);
-      clear_recursive(node->right);
-      destroy_node(node);
+  // Post-order walk over the tree using parent links, so deep trees need no
+  // recursion. `visit` may free the node it is given.
+  template <typename Visit> void for_each_postorder(Visit visit) noexcept {
+    Node *node = root;
+    Node *prev = nullptr;
+    while (node) {
+      if (prev == node->parent) {
+        if (node->left) {
+          prev = node;
+          node = node->left;
+          continue;
+        }
+        if (node->right) {
+          prev = node;
+          node = node->right;
+          continue;
+        }
+      } else if (prev == node->left && node->right) {
+        prev = node;
+        node = node->right;
+        continue;
+      }
+      Node *parent = node->parent;
+      visit(node);
+      prev = node;
+      node = parent;
     }
   }
 
+  // In-order walk over the tree using parent links.
+  template <typename Visit> void for_each_inorder(Visit visit) const {
+    const Node *node = root;
+    while (node && node->left) {
+      node = node->left;
+    }
+    while (node) {
+      visit(node);
+      if (node->right) {
+        node = node->right;
+        while (node->left) {
+          node = node->left;
+        }
+      } else {
+        const Node *child = node;
+        node = node->parent;
+        while (node && child == node->right) {
+          child = node;
+          node = node->parent;
+        }
+      }
+    }
+  }
+
+  // Frees every node. A map that is the sole owner of its node pool drops
+  // the chunks in one go and only walks the tree when the values have
+  // destructors to run.
+  void destroy_tree() noexcept {
+    if constexpr (requires(node_allocator &a) { a.release(); }) {
+      if (alloc.owns_pool()) {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+          for_each_postorder(
+              [this](Node *node) { alloc_traits::destroy(alloc, node); });
+        }
+        alloc.release();
+        return;
+      }
+    }
+    for_each_postorder([this](Node *node) { destroy_node(node); });
+  }
+
   Node *copy_tree(Node *other_node, Node *parent = nullptr) {
     if (!other_node)
       return nullptr;
-    Node *new_node =
-        create_node(other_node->data, parent, other_node->is_black);
+    Node *new_node = create_node(other_node->data);
+    new_node->parent = parent;
+    new_node->is_black = other_node->is_black;
     new_node->left = copy_tree(other_node->left, new_node);
     new_node->right = copy_tree(other_node->right, new_node);
     return new_node;
@@ -117,14 +298,25 @@ private:
 public:
   map() noexcept : root(nullptr), count(0) {}
 
+  // Ascending input is detected and built bottom-up in O(n); the remainder
+  // after the first out-of-order key is inserted one by one.
   template <typename InputIt> map(InputIt first, InputIt last) : map() {
-    for (; first != last; ++first) {
-      insert(*first);
-    }
+    build_from(first, last, false);
   }
 
   map(std::initializer_list<value_type> init) : map(init.begin(), init.end()) {}
 
+  // The caller guarantees strictly ascending keys, so no comparisons are made
+  // at all. A pool allocator serves all nodes from one contiguous chunk when
+  // the length of the range is known up front.
+  template <typename InputIt>
+  map(sorted_unique_t, InputIt first, InputIt last) : map() {
+    build_from(first, last, true);
+  }
+
+  map(sorted_unique_t, std::initializer_list<value_type> init)
+      : map(sorted_unique, init.begin(), init.end()) {}
+
   map(const map &other)
       : root(nullptr), count(0), comp(other.comp),
         alloc(
@@ -140,11 +332,13 @@ public:
     other.count = 0;
   }
 
-  ~map() { clear_recursive(root); }
+  ~map() { destroy_tree(); }
 
   map &operator=(const map &other) {
     if (this != &other) {
-      clear_recursive(root);
+      destroy_tree();
+      root = nullptr;
+      count = 0;
       comp = other.comp;
       if (alloc_traits::propagate_on_container_copy_assignment::value) {
         alloc = other.alloc;
@@ -157,7 +351,7 @@ public:
 
   map &operator=(map &&other) noexcept {
     if (this != &other) {
-      clear_recursive(root);
+      destroy_tree();
       comp = std::move(other.comp);
       if (alloc_traits::propagate_on_container_move_assignment::value) {
         alloc = std::move(other.alloc);
@@ -171,60 +365,109 @@ public:
   }
 
   map &operator=(std::initializer_list<value_type> ilist) {
-    clear_recursive(root);
-    root = nullptr;
-    count = 0;
-    for (const auto &item : ilist) {
-      insert(item);
-    }
+    clear();
+    build_from(ilist.begin(), ilist.end(), false);
     return *this;
   }
 
   std::pair<iterator<Key, T>, bool> insert(const value_type &value) {
-    Node *parent = nullptr;
-    Node *current = root;
-    bool is_left = false;
+    return try_emplace(value.first, value.second);
+  }
 
-    while (current) {
-      parent = current;
-      if (comp(value.first, current->data.first)) {
-        current = current->left;
-        is_left = true;
-      } else if (comp(current->data.first, value.first)) {
-        current = current->right;
-        is_left = false;
-      } else {
-        return {iterator<Key, T>(current), false};
-      }
-    }
+  std::pair<iterator<Key, T>, bool> insert(value_type &&value) {
+    return try_emplace(value.first, std::move(value.second));
+  }
 
-    Node *new_node = create_node(value, parent);
+  std::pair<iterator<Key, T>, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
 
-    if (!parent) {
-      root = new_node;
-    } else if (is_left) {
-      parent->left = new_node;
+  iterator<Key, T> insert(iterator<Key, T> hint, const value_type &value) {
+    return try_emplace(hint, value.first, value.second);
+  }
+
+  iterator<Key, T> insert(iterator<Key, T> hint, value_type &&value) {
+    return try_emplace(hint, value.first, std::move(value.second));
+  }
+
+  // Builds the value first when the key cannot be read from the arguments;
+  // a (key, mapped) argument pair takes the allocation-free try_emplace path.
+  template <typename... Args>
+  std::pair<iterator<Key, T>, bool> emplace(Args &&...args) {
+    if constexpr (sizeof...(Args) == 2 && is_key_first<Args...>) {
+      return try_emplace(std::forward<Args>(args)...);
     } else {
-      parent->right = new_node;
+      Node *node = create_node(std::forward<Args>(args)...);
+      insert_position pos = locate(node->data.first);
+      if (pos.existing) {
+        destroy_node(node);
+        return {make_iterator(pos.existing), false};
+      }
+      link_node(node, pos);
+      return {make_iterator(node), true};
     }
+  }
 
-    count++;
-    return {iterator<Key, T>(new_node), true};
+  template <typename... Args>
+  iterator<Key, T> emplace_hint(iterator<Key, T> hint, Args &&...args) {
+    Node *node = create_node(std::forward<Args>(args)...);
+    insert_position pos = locate(hint, node->data.first);
+    if (pos.existing) {
+      destroy_node(node);
+      return make_iterator(pos.existing);
+    }
+    link_node(node, pos);
+    return make_iterator(node);
   }
 
-  std::pair<iterator<Key, T>, bool> insert(const Key &key, const T &obj) {
-    return insert(value_type(key, obj));
+  // Constructs the mapped value from `args` only if `key` is absent; nothing
+  // is allocated or moved from when the key already exists.
+  template <typename... Args>
+  std::pair<iterator<Key, T>, bool> try_emplace(const Key &key,
+                                                Args &&...args) {
+    return try_emplace_at(locate(key), key, std::forward<Args>(args)...);
   }
 
-  std::pair<iterator<Key, T>, bool> insert_or_assign(const Key &key,
-                                                     const T &obj) {
-    auto result = insert(value_type(key, obj));
+  template <typename... Args>
+  std::pair<iterator<Key, T>, bool> try_emplace(Key &&key, Args &&...args) {
+    return try_emplace_at(locate(key), std::move(key),
+                          std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  iterator<Key, T> try_emplace(iterator<Key, T> hint, const Key &key,
+                               Args &&...args) {
+    return try_emplace_at(locate(hint, key), key, std::forward<Args>(args)...)
+        .first;
+  }
 
-    if (!result.second) {
-      result.first->second = obj;
+  template <typename... Args>
+  iterator<Key, T> try_emplace(iterator<Key, T> hint, Key &&key,
+                               Args &&...args) {
+    return try_emplace_at(locate(hint, key), std::move(key),
+                          std::forward<Args>(args)...)
+        .first;
+  }
+
+  template <typename M>
+  std::pair<iterator<Key, T>, bool> insert_or_assign(const Key &key,
+                                                     M &&obj) {
+    insert_position pos = locate(key);
+    if (pos.existing) {
+      pos.existing->data.second = std::forward<M>(obj);
+      return {make_iterator(pos.existing), false};
     }
+    return try_emplace_at(pos, key, std::forward<M>(obj));
+  }
 
-    return result;
+  template <typename M>
+  std::pair<iterator<Key, T>, bool> insert_or_assign(Key &&key, M &&obj) {
+    insert_position pos = locate(key);
+    if (pos.existing) {
+      pos.existing->data.second = std::forward<M>(obj);
+      return {make_iterator(pos.existing), false};
+    }
+    return try_emplace_at(pos, std::move(key), std::forward<M>(obj));
   }
 
   void swap(map &other) noexcept {
@@ -250,25 +493,73 @@ public:
       v->parent = u->parent;
   }
 
+  // Moves every node whose key is absent here out of `other`, relinking the
+  // nodes themselves: nothing is allocated, copied or moved. If `other` is
+  // large relative to this map, both trees are flattened, merged and rebuilt
+  // balanced in O(n + m); otherwise each node is relinked in O(log(n + m)).
+  // Nodes can only be shared when the allocators agree; a pool allocator
+  // first adopts the other map's pool, and if even that is impossible the
+  // values are moved into fresh nodes.
   void merge(map &other) {
-    if (this == &other)
+    if (this == &other || !other.root)
       return;
-    iterator it = other.begin();
-    while (it != other.end()) {
-      auto next = it;
-      ++next;
+    if (!(alloc == other.alloc)) {
+      bool shared = false;
+      if constexpr (requires(node_allocator &a) { a.adopt(a); }) {
+        shared = alloc.adopt(other.alloc);
+      }
+      if (!shared) {
+        merge_by_move(other);
+        return;
+      }
+    }
 
-      auto [pos, inserted] = insert(std::move(it.current->data));
+    size_type total = count + other.count;
+    size_type depth = 0;
+    while ((size_type(1) << depth) <= total) {
+      ++depth;
+    }
+    if (other.count * depth >= total) {
+      merge_linear(other);
+    } else {
+      merge_by_relink(other);
+    }
+  }
 
-      if (inserted) {
-        Node *node = it.current;
-        other.transplant(node, nullptr);
-        other.destroy_node(node);
-        other.count--;
-      }
+  node_type extract(iterator<Key, T> pos) {
+    if (pos == end())
+      return node_type();
+    unlink_node(pos.current);
+    return node_type(pos.current, alloc);
+  }
+
+  node_type extract(const Key &key) { return extract(find(key)); }
 
-      it = next;
+  // Links the handle's node in place when the key is absent. On a duplicate
+  // key the handle is returned untouched in `node`. The node can be linked
+  // when the allocators agree, or when a pool allocator can join the two
+  // pools: this map adopts the handle's pool, or failing that hands its own
+  // pool over to it. Otherwise the value is moved into a fresh node. Either
+  // way the handle is empty afterwards.
+  insert_return_type insert(node_type &&nh) {
+    if (nh.empty())
+      return {end(), false, node_type()};
+    insert_position pos = locate(nh.key());
+    if (pos.existing)
+      return {make_iterator(pos.existing), false, std::move(nh)};
+    bool shared = nh.alloc == alloc;
+    if constexpr (requires(node_allocator &a) { a.adopt(a); }) {
+      shared = shared || alloc.adopt(nh.alloc) || nh.alloc.adopt(alloc);
     }
+    if (shared) {
+      Node *node = nh.release();
+      reset_links(node);
+      link_node(node, pos);
+      return {make_iterator(node), true, node_type()};
+    }
+    auto result = try_emplace_at(pos, nh.key(), std::move(nh.mapped()));
+    nh.reset();
+    return {result.first, true, node_type()};
   }
 
   bool contains(const Key &key) const noexcept {
@@ -288,7 +579,7 @@ public:
   size_type size() const noexcept { return count; }
   bool empty() const noexcept { return count == 0; }
   void clear() noexcept {
-    clear_recursive(root);
+    destroy_tree();
     root = nullptr;
     count = 0;
   }
@@ -296,10 +587,53 @@ public:
     Node *leftmost = root;
     while (leftmost && leftmost->left)
       leftmost = leftmost->left;
-    return iterator<Key, T>(leftmost);
+    return make_iterator(leftmost);
+  }
+
+  iterator<Key, T> end() { return make_iterator(nullptr); }
+
+  iterator<Key, T> find(const Key &key) {
+    return make_iterator(find_node(key));
+  }
+
+  // First element whose key is not less than `key`.
+  iterator<Key, T> lower_bound(const Key &key) {
+    Node *current = root;
+    Node *result = nullptr;
+    while (current) {
+      if (!comp(current->data.first, key)) {
+        result = current;
+        current = current->left;
+      } else {
+        current = current->right;
+      }
+    }
+    return make_iterator(result);
+  }
+
+  // First element whose key is greater than `key`.
+  iterator<Key, T> upper_bound(const Key &key) {
+    Node *current = root;
+    Node *result = nullptr;
+    while (current) {
+      if (comp(key, current->data.first)) {
+        result = current;
+        current = current->left;
+      } else {
+        current = current->right;
+      }
+    }
+    return make_iterator(result);
   }
 
-  iterator<Key, T> end() { return iterator<Key, T>(nullptr); }
+  std::pair<iterator<Key, T>, iterator<Key, T>> equal_range(const Key &key) {
+    iterator<Key, T> first = lower_bound(key);
+    iterator<Key, T> last = first;
+    if (last != end() && !comp(key, last->first)) {
+      ++last;
+    }
+    return {first, last};
+  }
 
   T &operator[](const Key &key) {
     Node *node = find_node(key);
@@ -321,41 +655,523 @@ public:
     if (pos == end() || !root)
       return;
 
-    Node *to_delete = pos.current;
+    unlink_node(pos.current);
+    destroy_node(pos.current);
+  }
+
+  // Writes the map to `path` in the snapshot format of s21_map_snapshot.h:
+  // flat key and value arrays with a search index when Key and T are
+  // trivially copyable, so load_mapped() can use the file in place, and a
+  // stream of snapshot_traits records otherwise. The file is replaced
+  // atomically.
+  void save(const std::string &path) const {
+    auto for_each = [this](auto visit) {
+      for_each_inorder([&](const Node *node) {
+        visit(node->data.first, node->data.second);
+      });
+    };
+    snapshot::write_file(path, [&](std::ostream &out) {
+      if constexpr (std::is_trivially_copyable_v<Key> &&
+                    std::is_trivially_copyable_v<T>) {
+        snapshot::write_raw<Key, T>(out, count, for_each);
+      } else {
+        snapshot::write_records<Key, T>(out, count, for_each);
+      }
+    });
+  }
+
+  // Maps a snapshot written by save() read-only and searches it in place,
+  // with nothing deserialized. Needs trivially copyable Key and T.
+  static mapped_map<Key, T> load_mapped(const std::string &path) {
+    return mapped_map<Key, T>(path);
+  }
+
+  // Builds a map from a snapshot written by save(), for any Key and T. The
+  // elements arrive sorted, so the tree is built in one linear pass.
+  static map load(const std::string &path) {
+    if constexpr (std::is_trivially_copyable_v<Key> &&
+                  std::is_trivially_copyable_v<T>) {
+      mapped_map<Key, T> view(path);
+      return map(sorted_unique, view.begin(), view.end());
+    } else {
+      std::ifstream in(path, std::ios::binary);
+      if (!in) {
+        snapshot::fail(path, "cannot open for reading");
+      }
+      snapshot::header h;
+      in.read(reinterpret_cast<char *>(&h), sizeof(h));
+      if (!in) {
+        snapshot::fail(path, "too short to be a map snapshot");
+      }
+      snapshot::check_header<Key, T>(h, path);
+      if (h.layout != snapshot::records_layout) {
+        snapshot::fail(path, "unknown layout");
+      }
+      using reader = snapshot::record_reader<Key, T>;
+      return map(sorted_unique, std::make_move_iterator(reader(in, h.count, path)),
+                 std::make_move_iterator(reader()));
+    }
+  }
+
+  void print() const {
+    std::cout << "Map contents (in-order):\n";
+    print_in_order(root);
+    std::cout << "\n";
+  }
+
+private:
+  // Removes `to_delete` from the tree and rebalances, without freeing it.
+  void unlink_node(Node *to_delete) noexcept {
+    Node *spliced = to_delete;
+    bool removed_black = spliced->is_black;
+    Node *child;
+    Node *child_parent;
 
     if (to_delete->left == nullptr) {
+      child = to_delete->right;
+      child_parent = to_delete->parent;
       transplant(to_delete, to_delete->right);
     } else if (to_delete->right == nullptr) {
+      child = to_delete->left;
+      child_parent = to_delete->parent;
       transplant(to_delete, to_delete->left);
-    }
-    else {
-      Node *successor = to_delete->right;
-      while (successor->left != nullptr) {
-        successor = successor->left;
+    } else {
+      spliced = to_delete->right;
+      while (spliced->left != nullptr) {
+        spliced = spliced->left;
       }
+      removed_black = spliced->is_black;
+      child = spliced->right;
 
-      if (successor->parent != to_delete) {
-        transplant(successor, successor->right);
-        successor->right = to_delete->right;
-        successor->right->parent = successor;
+      if (spliced->parent != to_delete) {
+        child_parent = spliced->parent;
+        transplant(spliced, spliced->right);
+        spliced->right = to_delete->right;
+        spliced->right->parent = spliced;
+      } else {
+        child_parent = spliced;
       }
 
-      transplant(to_delete, successor);
-      successor->left = to_delete->left;
-      successor->left->parent = successor;
+      transplant(to_delete, spliced);
+      spliced->left = to_delete->left;
+      spliced->left->parent = spliced;
+      spliced->is_black = to_delete->is_black;
     }
 
-    delete to_delete;
     --count;
+
+    if (removed_black) {
+      erase_fixup(child, child_parent);
+    }
   }
 
-  void print() const {
-    std::cout << "Map contents (in-order):\n";
-    print_in_order(root);
-    std::cout << "\n";
+  // Fills an empty map from [first, last). The ascending prefix of the input
+  // is collected into a list and built balanced in O(n); anything after it
+  // goes through insert. With `sorted` the whole input is trusted to be
+  // strictly ascending.
+  template <typename InputIt>
+  void build_from(InputIt first, InputIt last, bool sorted) {
+    if constexpr (std::is_base_of_v<
+                      std::forward_iterator_tag,
+                      typename std::iterator_traits<InputIt>::iterator_category>) {
+      if constexpr (requires(node_allocator &a) { a.reserve(size_type{}); }) {
+        alloc.reserve(static_cast<size_type>(std::distance(first, last)));
+      }
+    }
+
+    Node *head = nullptr;
+    Node **tail = &head;
+    Node *prev = nullptr;
+    size_type n = 0;
+    try {
+      for (; first != last; ++first) {
+        if (!sorted && prev && !comp(prev->data.first, (*first).first)) {
+          break;
+        }
+        Node *node = create_node(*first);
+        *tail = node;
+        tail = &node->right;
+        prev = node;
+        ++n;
+      }
+    } catch (...) {
+      *tail = nullptr;
+      while (head) {
+        Node *next = head->right;
+        destroy_node(head);
+        head = next;
+      }
+      throw;
+    }
+    *tail = nullptr;
+    root = build_balanced(head, n);
+    count = n;
+
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  static void reset_links(Node *node) noexcept {
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+    node->is_black = false;
+  }
+
+  void merge_by_relink(map &other) {
+    Node *node = other.begin().current;
+    while (node) {
+      Node *next = std::next(other.make_iterator(node)).current;
+      insert_position pos = locate(node->data.first);
+      if (!pos.existing) {
+        other.unlink_node(node);
+        reset_links(node);
+        link_node(node, pos);
+      }
+      node = next;
+    }
+  }
+
+  void merge_by_move(map &other) {
+    Node *node = other.begin().current;
+    while (node) {
+      Node *next = std::next(other.make_iterator(node)).current;
+      insert_position pos = locate(node->data.first);
+      if (!pos.existing) {
+        try_emplace_at(pos, node->data.first, std::move(node->data.second));
+        other.unlink_node(node);
+        other.destroy_node(node);
+      }
+      node = next;
+    }
+  }
+
+  void merge_linear(map &other) noexcept {
+    Node *mine = flatten(root);
+    Node *theirs = flatten(other.root);
+    Node *merged = nullptr;
+    Node **merged_tail = &merged;
+    Node *kept = nullptr;
+    Node **kept_tail = &kept;
+    size_type kept_count = 0;
+
+    while (mine || theirs) {
+      Node *next;
+      if (!theirs || (mine && comp(mine->data.first, theirs->data.first))) {
+        next = mine;
+        mine = mine->right;
+      } else if (!mine || comp(theirs->data.first, mine->data.first)) {
+        next = theirs;
+        theirs = theirs->right;
+      } else {
+        *kept_tail = theirs;
+        kept_tail = &theirs->right;
+        theirs = theirs->right;
+        ++kept_count;
+        continue;
+      }
+      *merged_tail = next;
+      merged_tail = &next->right;
+    }
+    *merged_tail = nullptr;
+    *kept_tail = nullptr;
+
+    count = count + other.count - kept_count;
+    other.count = kept_count;
+    root = build_balanced(merged, count);
+    other.root = build_balanced(kept, kept_count);
+  }
+
+  // Threads the nodes of the tree rooted at `node` into an ascending list
+  // linked through `right`. Walks from the maximum backwards, which only
+  // reads `right` links of nodes that have not been relinked yet.
+  static Node *flatten(Node *node) noexcept {
+    if (!node)
+      return nullptr;
+    while (node->right)
+      node = node->right;
+    Node *head = nullptr;
+    while (node) {
+      Node *prev;
+      if (node->left) {
+        prev = node->left;
+        while (prev->right)
+          prev = prev->right;
+      } else {
+        Node *current = node;
+        prev = current->parent;
+        while (prev && current == prev->left) {
+          current = prev;
+          prev = prev->parent;
+        }
+      }
+      node->right = head;
+      head = node;
+      node = prev;
+    }
+    return head;
+  }
+
+  // Builds a balanced tree from the first `n` nodes of the `right`-linked
+  // list at `head` in O(n). Every level but the deepest is full; nodes on
+  // an incomplete deepest level are red and the rest black, which gives all
+  // paths the same black height.
+  static Node *build_balanced(Node *head, size_type n) noexcept {
+    size_type red_depth = 0;
+    while ((size_type(2) << red_depth) <= n + 1) {
+      ++red_depth;
+    }
+    Node *tree = build_balanced(head, n, nullptr, 0, red_depth);
+    return tree;
+  }
+
+  static Node *build_balanced(Node *&head, size_type n, Node *parent,
+                              size_type depth, size_type red_depth) noexcept {
+    if (n == 0)
+      return nullptr;
+    size_type left_count = (n - 1) / 2;
+    Node *left = build_balanced(head, left_count, nullptr, depth + 1,
+                                red_depth);
+    Node *node = head;
+    head = head->right;
+    node->parent = parent;
+    node->left = left;
+    if (left)
+      left->parent = node;
+    node->is_black = depth != red_depth || depth == 0;
+    node->right = build_balanced(head, n - 1 - left_count, node, depth + 1,
+                                 red_depth);
+    return node;
+  }
+  iterator<Key, T> make_iterator(Node *node) noexcept {
+    return iterator<Key, T>(node, &root);
+  }
+
+  template <typename First, typename...>
+  static constexpr bool is_key_first =
+      std::is_same_v<std::remove_cvref_t<First>, Key>;
+
+  // Where a key lives or would be attached: either the node already holding
+  // it, or the parent and side a new node should be linked under.
+  struct insert_position {
+    Node *existing;
+    Node *parent;
+    bool is_left;
+  };
+
+  insert_position locate(const Key &key) const {
+    Node *parent = nullptr;
+    Node *current = root;
+    bool is_left = false;
+
+    while (current) {
+      parent = current;
+      if (comp(key, current->data.first)) {
+        current = current->left;
+        is_left = true;
+      } else if (comp(current->data.first, key)) {
+        current = current->right;
+        is_left = false;
+      } else {
+        return {current, nullptr, false};
+      }
+    }
+    return {nullptr, parent, is_left};
+  }
+
+  // Hinted lookup: if `key` belongs immediately before `hint`, it is attached
+  // next to the hint without a search from the root. Otherwise falls back to
+  // the full descent.
+  insert_position locate(iterator<Key, T> hint, const Key &key) {
+    if (!root) {
+      return {nullptr, nullptr, false};
+    }
+    Node *next = hint.current;
+    if (next && !comp(key, next->data.first)) {
+      return locate(key);
+    }
+    // Stepping back from the leftmost node climbs past the root and yields
+    // null, so the first element is detected without a walk from the root.
+    iterator<Key, T> prev_it = hint;
+    Node *prev = (--prev_it).current;
+    if (prev && !comp(prev->data.first, key)) {
+      return locate(key);
+    }
+    if (next && !next->left) {
+      return {nullptr, next, true};
+    }
+    return {nullptr, prev, false};
+  }
+
+  void link_node(Node *node, const insert_position &pos) noexcept {
+    node->parent = pos.parent;
+    if (!pos.parent) {
+      root = node;
+    } else if (pos.is_left) {
+      pos.parent->left = node;
+    } else {
+      pos.parent->right = node;
+    }
+    insert_fixup(node);
+    ++count;
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator<Key, T>, bool>
+  try_emplace_at(const insert_position &pos, K &&key, Args &&...args) {
+    if (pos.existing) {
+      return {make_iterator(pos.existing), false};
+    }
+    Node *node = create_node(std::piecewise_construct,
+                             std::forward_as_tuple(std::forward<K>(key)),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+    link_node(node, pos);
+    return {make_iterator(node), true};
+  }
+
+  static bool is_black(const Node *node) noexcept {
+    return !node || node->is_black;
+  }
+
+  void rotate_left(Node *x) noexcept {
+    Node *y = x->right;
+    x->right = y->left;
+    if (y->left)
+      y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) {
+      root = y;
+    } else if (x == x->parent->left) {
+      x->parent->left = y;
+    } else {
+      x->parent->right = y;
+    }
+    y->left = x;
+    x->parent = y;
+  }
+
+  void rotate_right(Node *x) noexcept {
+    Node *y = x->left;
+    x->left = y->right;
+    if (y->right)
+      y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) {
+      root = y;
+    } else if (x == x->parent->right) {
+      x->parent->right = y;
+    } else {
+      x->parent->left = y;
+    }
+    y->right = x;
+    x->parent = y;
+  }
+
+  // Restores the red-black properties after linking the red leaf `node`.
+  void insert_fixup(Node *node) noexcept {
+    while (node->parent && !node->parent->is_black) {
+      Node *parent = node->parent;
+      Node *grandparent = parent->parent;
+      if (parent == grandparent->left) {
+        Node *uncle = grandparent->right;
+        if (!is_black(uncle)) {
+          parent->is_black = true;
+          uncle->is_black = true;
+          grandparent->is_black = false;
+          node = grandparent;
+        } else {
+          if (node == parent->right) {
+            node = parent;
+            rotate_left(node);
+            parent = node->parent;
+          }
+          parent->is_black = true;
+          grandparent->is_black = false;
+          rotate_right(grandparent);
+        }
+      } else {
+        Node *uncle = grandparent->left;
+        if (!is_black(uncle)) {
+          parent->is_black = true;
+          uncle->is_black = true;
+          grandparent->is_black = false;
+          node = grandparent;
+        } else {
+          if (node == parent->left) {
+            node = parent;
+            rotate_right(node);
+            parent = node->parent;
+          }
+          parent->is_black = true;
+          grandparent->is_black = false;
+          rotate_left(grandparent);
+        }
+      }
+    }
+    root->is_black = true;
+  }
+
+  // Restores the red-black properties after a black node was unlinked.
+  // `node` took its place (and may be null), `parent` is its new parent.
+  void erase_fixup(Node *node, Node *parent) noexcept {
+    while (node != root && is_black(node)) {
+      if (node == parent->left) {
+        Node *sibling = parent->right;
+        if (!is_black(sibling)) {
+          sibling->is_black = true;
+          parent->is_black = false;
+          rotate_left(parent);
+          sibling = parent->right;
+        }
+        if (is_black(sibling->left) && is_black(sibling->right)) {
+          sibling->is_black = false;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (is_black(sibling->right)) {
+            sibling->left->is_black = true;
+            sibling->is_black = false;
+            rotate_right(sibling);
+            sibling = parent->right;
+          }
+          sibling->is_black = parent->is_black;
+          parent->is_black = true;
+          sibling->right->is_black = true;
+          rotate_left(parent);
+          node = root;
+        }
+      } else {
+        Node *sibling = parent->left;
+        if (!is_black(sibling)) {
+          sibling->is_black = true;
+          parent->is_black = false;
+          rotate_right(parent);
+          sibling = parent->left;
+        }
+        if (is_black(sibling->left) && is_black(sibling->right)) {
+          sibling->is_black = false;
+          node = parent;
+          parent = node->parent;
+        } else {
+          if (is_black(sibling->left)) {
+            sibling->right->is_black = true;
+            sibling->is_black = false;
+            rotate_left(sibling);
+            sibling = parent->left;
+          }
+          sibling->is_black = parent->is_black;
+          parent->is_black = true;
+          sibling->left->is_black = true;
+          rotate_right(parent);
+          node = root;
+        }
+      }
+    }
+    if (node)
+      node->is_black = true;
   }
 
-private:
   Node *find_node(const Key &key) const {
     Node *current = root;
     while (current) {
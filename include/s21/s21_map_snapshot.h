@@ -0,0 +1,562 @@
+#include "s21_vector.h"
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <compare>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+#ifndef MAP_SNAPSHOT_H
+#define MAP_SNAPSHOT_H
+
+namespace s21 {
+// How a key or mapped value is written to a snapshot stream. Trivially
+// copyable types are written as their bytes and std::string as its length
+// and characters; specialize this for any other type to be saved.
+template <typename T, typename = void> struct snapshot_traits;
+
+template <typename T>
+struct snapshot_traits<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+  static void write(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  static T read(std::istream &in) {
+    std::array<char, sizeof(T)> bytes;
+    in.read(bytes.data(), sizeof(T));
+    return std::bit_cast<T>(bytes);
+  }
+};
+
+template <> struct snapshot_traits<std::string> {
+  static void write(std::ostream &out, const std::string &value) {
+    std::uint64_t length = value.size();
+    out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    out.write(value.data(), static_cast<std::streamsize>(length));
+  }
+  // The length comes from the file, so the characters are read in bounded
+  // steps: a corrupt length runs into the end of the stream, which the
+  // caller reports, instead of allocating whatever it says up front.
+  static std::string read(std::istream &in) {
+    constexpr std::uint64_t step = std::uint64_t{1} << 16;
+    std::uint64_t length = snapshot_traits<std::uint64_t>::read(in);
+    std::string value;
+    while (in && value.size() < length) {
+      std::size_t done = value.size();
+      std::size_t n = static_cast<std::size_t>(
+          length - done < step ? length - done : step);
+      value.resize(done + n);
+      in.read(value.data() + done, static_cast<std::streamsize>(n));
+    }
+    return value;
+  }
+};
+
+// On-disk layout written by s21::map::save(). A 128-byte header is followed
+// by one of two bodies:
+//
+//  - raw, when Key and T are both trivially copyable: the sorted keys, the
+//    values in the same order, and an index holding the last key of every
+//    block of `block_size` keys in Eytzinger (BFS) order. An entry's block
+//    number follows from its position, so it is not stored. Every array
+//    starts on a 64-byte boundary, so mapped_map reads them in place.
+//  - records, for any other types: `count` key/value pairs in key order,
+//    each written through snapshot_traits and read back as a stream.
+//
+// Files are only readable on a machine with the same byte order and type
+// sizes; the header records both and loading checks them.
+namespace snapshot {
+inline constexpr std::uint64_t magic = 0x3176'5041'4D31'3253; // "S21MAPv1"
+inline constexpr std::uint32_t version = 1;
+inline constexpr std::uint32_t records_layout = 0;
+inline constexpr std::uint32_t raw_layout = 1;
+inline constexpr std::uint64_t block_size = 16;
+inline constexpr std::uint64_t array_alignment = 64;
+
+struct header {
+  std::uint64_t magic;
+  std::uint32_t version;
+  std::uint32_t layout;
+  std::uint64_t count;
+  std::uint32_t key_size;
+  std::uint32_t key_align;
+  std::uint32_t mapped_size;
+  std::uint32_t mapped_align;
+  std::uint64_t block_size;
+  std::uint64_t keys_offset;
+  std::uint64_t values_offset;
+  std::uint64_t index_count;
+  std::uint64_t index_keys_offset;
+  std::uint64_t file_size;
+  std::uint64_t reserved[5];
+};
+static_assert(sizeof(header) == 128);
+
+inline std::uint64_t align_up(std::uint64_t offset) noexcept {
+  return (offset + array_alignment - 1) / array_alignment * array_alignment;
+}
+
+[[noreturn]] inline void fail(const std::string &path, const char *what) {
+  throw std::runtime_error("Map snapshot. " + path + ": " + what);
+}
+
+template <typename Key, typename T>
+header make_header(std::uint32_t layout, std::uint64_t count) {
+  header h{};
+  h.magic = magic;
+  h.version = version;
+  h.layout = layout;
+  h.count = count;
+  h.key_size = sizeof(Key);
+  h.key_align = alignof(Key);
+  h.mapped_size = sizeof(T);
+  h.mapped_align = alignof(T);
+  h.block_size = block_size;
+  return h;
+}
+
+template <typename Key, typename T>
+void check_header(const header &h, const std::string &path) {
+  if (h.magic != magic || h.version != version) {
+    fail(path, "not a map snapshot of this version and byte order");
+  }
+  if (h.key_size != sizeof(Key) || h.key_align != alignof(Key) ||
+      h.mapped_size != sizeof(T) || h.mapped_align != alignof(T)) {
+    fail(path, "key or mapped type does not match the saved one");
+  }
+}
+
+// Flushes `path`, a file or a directory, to the disk.
+inline bool sync_path(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  bool synced = ::fsync(fd) == 0;
+  ::close(fd);
+  return synced;
+}
+
+// Writes through a temporary file that is synced and then renamed over
+// `path`, and syncs the directory after the rename, so neither a crash nor
+// a power loss leaves a torn snapshot behind: `path` holds either the old
+// file or the complete new one.
+template <typename Write> void write_file(const std::string &path, Write write) {
+  std::string tmp = path + ".tmp";
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      fail(path, "cannot open for writing");
+    }
+    write(out);
+    out.flush();
+    if (!out) {
+      std::remove(tmp.c_str());
+      fail(path, "write failed");
+    }
+  }
+  if (!sync_path(tmp)) {
+    std::remove(tmp.c_str());
+    fail(path, "cannot sync the file");
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    fail(path, "cannot replace the file");
+  }
+  std::string::size_type slash = path.rfind('/');
+  std::string dir = slash == std::string::npos ? "."
+                    : slash == 0               ? "/"
+                                               : path.substr(0, slash);
+  if (!sync_path(dir)) {
+    fail(path, "cannot sync the directory");
+  }
+}
+
+inline void pad_to(std::ostream &out, std::uint64_t offset) {
+  static const char zeros[array_alignment] = {};
+  std::uint64_t at = static_cast<std::uint64_t>(out.tellp());
+  out.write(zeros, static_cast<std::streamsize>(offset - at));
+}
+
+// Fills `tree[1..m]` with `sorted[0..m)` in Eytzinger order.
+template <typename Key>
+void eytzinger_fill(vector<Key> &tree, const vector<Key> &sorted,
+                    std::size_t &next, std::size_t k) {
+  if (k < tree.size()) {
+    eytzinger_fill(tree, sorted, next, 2 * k);
+    tree[k] = sorted[next++];
+    eytzinger_fill(tree, sorted, next, 2 * k + 1);
+  }
+}
+
+// The position in sorted order of node `k` of an `n`-node Eytzinger tree,
+// for 1 <= k <= n. Node k at depth d would sit at `perfect` in a perfect
+// tree; the bottom level is filled from the left, so the leaf slots missing
+// from it all come after the first `leaves` leaves and only those before
+// `perfect` (leaves sit at its even positions) are taken off.
+inline std::uint64_t eytzinger_rank(std::uint64_t k, std::uint64_t n) noexcept {
+  int height = std::bit_width(n);
+  int depth = std::bit_width(k) - 1;
+  std::uint64_t row = std::uint64_t{1} << depth;
+  std::uint64_t perfect = ((2 * (k - row) + 1) << (height - 1 - depth)) - 1;
+  std::uint64_t leaves = n - ((std::uint64_t{1} << (height - 1)) - 1);
+  std::uint64_t before = (perfect + 1) / 2;
+  return before > leaves ? perfect - (before - leaves) : perfect;
+}
+
+// Writes the raw layout for `count` elements, which `for_each` hands to its
+// visitor in key order.
+template <typename Key, typename T, typename ForEach>
+void write_raw(std::ostream &out, std::uint64_t count, ForEach for_each) {
+  std::uint64_t blocks = (count + block_size - 1) / block_size;
+  header h = make_header<Key, T>(raw_layout, count);
+  h.keys_offset = align_up(sizeof(header));
+  h.values_offset = align_up(h.keys_offset + count * sizeof(Key));
+  h.index_count = blocks;
+  h.index_keys_offset = align_up(h.values_offset + count * sizeof(T));
+  h.file_size = h.index_keys_offset + (blocks + 1) * sizeof(Key);
+  out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+
+  // One pass over the map writes the keys and keeps the values and every
+  // block's last key; the values go out after the keys.
+  vector<T> values;
+  vector<Key> block_last;
+  values.reserve(count);
+  block_last.reserve(blocks);
+  pad_to(out, h.keys_offset);
+  std::uint64_t i = 0;
+  for_each([&](const Key &key, const T &value) {
+    out.write(reinterpret_cast<const char *>(&key), sizeof(Key));
+    values.push_back(value);
+    if (i % block_size == block_size - 1 || i == count - 1) {
+      block_last.push_back(key);
+    }
+    ++i;
+  });
+  pad_to(out, h.values_offset);
+  out.write(reinterpret_cast<const char *>(values.data()),
+            static_cast<std::streamsize>(count * sizeof(T)));
+
+  // Slot 0 of the index is unused, so a node's children sit at 2k and
+  // 2k + 1.
+  vector<Key> tree(blocks + 1);
+  std::size_t next = 0;
+  eytzinger_fill(tree, block_last, next, 1);
+  pad_to(out, h.index_keys_offset);
+  out.write(reinterpret_cast<const char *>(tree.data()),
+            static_cast<std::streamsize>((blocks + 1) * sizeof(Key)));
+}
+
+// Writes the records layout: the header, then every element through
+// snapshot_traits in key order.
+template <typename Key, typename T, typename ForEach>
+void write_records(std::ostream &out, std::uint64_t count, ForEach for_each) {
+  header h = make_header<Key, T>(records_layout, count);
+  out.write(reinterpret_cast<const char *>(&h), sizeof(h));
+  for_each([&](const Key &key, const T &value) {
+    snapshot_traits<Key>::write(out, key);
+    snapshot_traits<T>::write(out, value);
+  });
+}
+
+// Input iterator over the records of a records-layout snapshot; used with
+// std::move_iterator so every pair is moved into the map it builds.
+template <typename Key, typename T> class record_reader {
+public:
+  using value_type = std::pair<Key, T>;
+  using reference = value_type &;
+  using pointer = value_type *;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::input_iterator_tag;
+
+  record_reader() = default;
+  record_reader(std::istream &in, std::uint64_t count, const std::string &path)
+      : in_(&in), left_(count), path_(&path) {
+    read_next();
+  }
+
+  reference operator*() const { return *current_; }
+  pointer operator->() const { return &*current_; }
+  record_reader &operator++() {
+    --left_;
+    read_next();
+    return *this;
+  }
+  void operator++(int) { ++*this; }
+  bool operator==(const record_reader &other) const {
+    return left_ == other.left_;
+  }
+
+private:
+  void read_next() {
+    if (left_ == 0) {
+      return;
+    }
+    Key key = snapshot_traits<Key>::read(*in_);
+    T value = snapshot_traits<T>::read(*in_);
+    if (!*in_) {
+      fail(*path_, "file ends before its last element");
+    }
+    current_.emplace(std::move(key), std::move(value));
+  }
+
+  std::istream *in_ = nullptr;
+  std::uint64_t left_ = 0;
+  const std::string *path_ = nullptr;
+  mutable std::optional<value_type> current_;
+};
+}
+
+// Read-only ordered map over a raw-layout snapshot file, used in place from
+// a read-only mapping: opening it costs an mmap and a header check however
+// large the file is, and pages are read in as lookups touch them. A lookup
+// walks the small Eytzinger index of block boundaries and then binary
+// searches one block of 16 keys.
+//
+// Returned by s21::map::load_mapped(). Key and T must be trivially
+// copyable.
+template <typename Key, typename T> class mapped_map {
+  static_assert(std::is_trivially_copyable_v<Key> &&
+                    std::is_trivially_copyable_v<T>,
+                "mapped_map needs trivially copyable Key and T");
+
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = std::size_t;
+  using key_compare = std::less<Key>;
+
+  // Elements are stored as two arrays, so dereferencing yields a pair of
+  // references into them.
+  class iterator {
+  public:
+    using value_type = std::pair<Key, T>;
+    using reference = std::pair<const Key &, const T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    struct pointer {
+      reference ref;
+      reference *operator->() noexcept { return &ref; }
+    };
+
+    iterator() = default;
+
+    reference operator*() const { return {*key, *value}; }
+    pointer operator->() const { return {**this}; }
+
+    iterator &operator++() {
+      ++key;
+      ++value;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    iterator &operator--() {
+      --key;
+      --value;
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const { return key == other.key; }
+
+  private:
+    friend class mapped_map;
+
+    iterator(const Key *k, const T *v) : key(k), value(v) {}
+
+    const Key *key = nullptr;
+    const T *value = nullptr;
+  };
+
+  mapped_map() noexcept = default;
+
+  explicit mapped_map(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(),
+                              "Map snapshot. " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(),
+                              "Map snapshot. " + path);
+    }
+    length_ = static_cast<size_type>(st.st_size);
+    if (length_ < sizeof(snapshot::header)) {
+      ::close(fd);
+      snapshot::fail(path, "too short to be a map snapshot");
+    }
+    void *p = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(),
+                              "Map snapshot. " + path);
+    }
+    base_ = static_cast<const unsigned char *>(p);
+    try {
+      adopt(path);
+    } catch (...) {
+      ::munmap(const_cast<unsigned char *>(base_), length_);
+      throw;
+    }
+  }
+
+  mapped_map(const mapped_map &) = delete;
+  mapped_map &operator=(const mapped_map &) = delete;
+
+  mapped_map(mapped_map &&other) noexcept { swap(other); }
+
+  mapped_map &operator=(mapped_map &&other) noexcept {
+    if (this != &other) {
+      mapped_map moved(std::move(other));
+      swap(moved);
+    }
+    return *this;
+  }
+
+  ~mapped_map() {
+    if (base_) {
+      ::munmap(const_cast<unsigned char *>(base_), length_);
+    }
+  }
+
+  void swap(mapped_map &other) noexcept {
+    std::swap(base_, other.base_);
+    std::swap(length_, other.length_);
+    std::swap(keys_, other.keys_);
+    std::swap(values_, other.values_);
+    std::swap(index_keys_, other.index_keys_);
+    std::swap(count_, other.count_);
+    std::swap(index_count_, other.index_count_);
+  }
+
+  iterator begin() const noexcept { return {keys_, values_}; }
+  iterator end() const noexcept { return {keys_ + count_, values_ + count_}; }
+
+  size_type size() const noexcept { return count_; }
+  bool empty() const noexcept { return count_ == 0; }
+
+  // The sorted keys and the values in the same order, for scans.
+  std::span<const Key> keys() const noexcept { return {keys_, count_}; }
+  std::span<const T> values() const noexcept { return {values_, count_}; }
+
+  iterator lower_bound(const Key &key) const {
+    size_type i = lower_bound_index(key);
+    return {keys_ + i, values_ + i};
+  }
+
+  iterator find(const Key &key) const {
+    size_type i = lower_bound_index(key);
+    if (i == count_ || key < keys_[i]) {
+      return end();
+    }
+    return {keys_ + i, values_ + i};
+  }
+
+  bool contains(const Key &key) const { return find(key) != end(); }
+
+  const T &at(const Key &key) const {
+    iterator it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("Key not found in map");
+    }
+    return *it.value;
+  }
+
+private:
+  const unsigned char *base_ = nullptr;
+  size_type length_ = 0;
+  const Key *keys_ = nullptr;
+  const T *values_ = nullptr;
+  const Key *index_keys_ = nullptr;
+  size_type count_ = 0;
+  size_type index_count_ = 0;
+
+  template <typename U>
+  const U *array_at(std::uint64_t offset, std::uint64_t n,
+                    const std::string &path) const {
+    if (offset % alignof(U) != 0 || offset > length_ ||
+        n > (length_ - offset) / sizeof(U)) {
+      snapshot::fail(path, "array lies outside the file");
+    }
+    return reinterpret_cast<const U *>(base_ + offset);
+  }
+
+  void adopt(const std::string &path) {
+    snapshot::header h;
+    std::memcpy(&h, base_, sizeof(h));
+    snapshot::check_header<Key, T>(h, path);
+    if (h.layout != snapshot::raw_layout ||
+        h.block_size != snapshot::block_size || h.file_size != length_) {
+      snapshot::fail(path, "not a raw snapshot that can be mapped");
+    }
+    count_ = static_cast<size_type>(h.count);
+    index_count_ = static_cast<size_type>(h.index_count);
+    if (index_count_ != (count_ + h.block_size - 1) / h.block_size) {
+      snapshot::fail(path, "index does not match the element count");
+    }
+    keys_ = array_at<Key>(h.keys_offset, h.count, path);
+    values_ = array_at<T>(h.values_offset, h.count, path);
+    index_keys_ = array_at<Key>(h.index_keys_offset, h.index_count + 1, path);
+  }
+
+  // The first block whose last key is not less than `key` comes from the
+  // Eytzinger index: descend while counting right turns in `k`, then drop
+  // the trailing right turns to land on the answer (or on 0 when every key
+  // is smaller). The block number is worked out from that position rather
+  // than read from the file, so even a corrupt index keeps the search
+  // inside `keys_`. The block itself is searched branch-free.
+  size_type lower_bound_index(const Key &key) const {
+    size_type k = 1;
+    while (k <= index_count_) {
+      k = 2 * k + static_cast<size_type>(index_keys_[k] < key);
+    }
+    k >>= std::countr_one(k) + 1;
+    if (k == 0) {
+      return count_;
+    }
+    size_type first =
+        static_cast<size_type>(snapshot::eytzinger_rank(k, index_count_)) *
+        static_cast<size_type>(snapshot::block_size);
+    size_type n = count_ - first < snapshot::block_size
+                      ? count_ - first
+                      : static_cast<size_type>(snapshot::block_size);
+    const Key *base = keys_ + first;
+    while (n > 1) {
+      size_type half = n / 2;
+      base = base[half - 1] < key ? base + half : base;
+      n -= half;
+    }
+    return static_cast<size_type>(base - keys_) +
+           static_cast<size_type>(*base < key);
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <sys/mman.h>
+#include <type_traits>
+
+#ifndef MMAP_ALLOCATOR_H
+#define MMAP_ALLOCATOR_H
+
+namespace s21 {
+// Allocator for very large arrays. Blocks of at least `Threshold` bytes are
+// anonymous mappings sized in whole huge pages and marked MADV_HUGEPAGE
+// where the kernel supports it, so a scan takes one TLB entry per 2 MiB
+// instead of per 4 KiB. Smaller blocks come from std::allocator.
+//
+// reallocate() grows or shrinks a block the way realloc does. Between two
+// mappings it uses mremap on Linux, which moves page table entries rather
+// than bytes. s21::vector calls it for trivially relocatable elements, so
+// growing such a vector copies nothing once it is mapped:
+//
+//   s21::vector<float, s21::mmap_allocator<float>> samples;
+template <typename T, size_t Threshold = size_t{1} << 21>
+class mmap_allocator {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using propagate_on_container_move_assignment = std::true_type;
+  using is_always_equal = std::true_type;
+
+  template <typename U> struct rebind {
+    using other = mmap_allocator<U, Threshold>;
+  };
+
+  static constexpr size_type huge_page = size_type{1} << 21;
+
+  mmap_allocator() noexcept = default;
+  template <typename U>
+  mmap_allocator(const mmap_allocator<U, Threshold> &) noexcept {}
+
+  T *allocate(size_type n) {
+    if (n > max_size()) {
+      throw std::bad_array_new_length();
+    }
+    if (!is_mapped(n)) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T *>(map(mapped_bytes(n)));
+  }
+
+  void deallocate(T *p, size_type n) noexcept {
+    if (is_mapped(n)) {
+      ::munmap(p, mapped_bytes(n));
+    } else {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  // Returns a block of `new_n` elements that starts with the first
+  // min(old_n, new_n) elements of `p`, moved bitwise, and frees `p`. Only
+  // valid for types that may be relocated with memcpy. On failure throws
+  // std::bad_alloc and leaves `p` untouched.
+  T *reallocate(T *p, size_type old_n, size_type new_n) {
+    if (new_n > max_size()) {
+      throw std::bad_array_new_length();
+    }
+    if (is_mapped(old_n) && is_mapped(new_n)) {
+      size_type old_bytes = mapped_bytes(old_n);
+      size_type new_bytes = mapped_bytes(new_n);
+      if (old_bytes == new_bytes) {
+        return p;
+      }
+#ifdef MREMAP_MAYMOVE
+      // Shrinking, or growing into free address space, keeps the block
+      // where it is.
+      if (::mremap(p, old_bytes, new_bytes, 0) != MAP_FAILED) {
+        advise(p, new_bytes);
+        return p;
+      }
+#ifdef MREMAP_FIXED
+      // Otherwise the pages move onto a fresh range that starts on a huge
+      // page boundary, which mremap replaces; letting the kernel pick the
+      // address could lose that alignment.
+      void *target = map(new_bytes);
+      void *moved = ::mremap(p, old_bytes, new_bytes,
+                             MREMAP_MAYMOVE | MREMAP_FIXED, target);
+      if (moved == MAP_FAILED) {
+        ::munmap(target, new_bytes);
+        throw std::bad_alloc();
+      }
+      advise(moved, new_bytes);
+      return static_cast<T *>(moved);
+#endif
+#endif
+    }
+    T *fresh = allocate(new_n);
+    size_type kept = old_n < new_n ? old_n : new_n;
+    if (kept > 0) {
+      std::memcpy(static_cast<void *>(fresh), static_cast<void *>(p),
+                  kept * sizeof(T));
+    }
+    deallocate(p, old_n);
+    return fresh;
+  }
+
+  static constexpr size_type max_size() noexcept {
+    return (PTRDIFF_MAX - huge_page) / sizeof(T);
+  }
+
+  bool operator==(const mmap_allocator &) const noexcept { return true; }
+
+private:
+  static constexpr bool is_mapped(size_type n) noexcept {
+    return n * sizeof(T) >= Threshold;
+  }
+
+  static constexpr size_type mapped_bytes(size_type n) noexcept {
+    return (n * sizeof(T) + huge_page - 1) / huge_page * huge_page;
+  }
+
+  static void advise([[maybe_unused]] void *p,
+                     [[maybe_unused]] size_type bytes) noexcept {
+#ifdef MADV_HUGEPAGE
+    ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+  }
+
+  // Maps one huge page more than needed and trims both ends, so the block
+  // starts on a huge page boundary and can be backed by huge pages whole.
+  static void *map(size_type bytes) {
+    size_type padded = bytes + huge_page;
+    void *p = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    char *raw = static_cast<char *>(p);
+    char *aligned = reinterpret_cast<char *>(
+        (reinterpret_cast<std::uintptr_t>(raw) + huge_page - 1) &
+        ~(huge_page - 1));
+    if (aligned != raw) {
+      ::munmap(raw, static_cast<size_type>(aligned - raw));
+    }
+    size_type tail = padded - static_cast<size_type>(aligned - raw) - bytes;
+    if (tail > 0) {
+      ::munmap(aligned + bytes, tail);
+    }
+    advise(aligned, bytes);
+    return aligned;
+  }
+};
+
+}
+
+#endif
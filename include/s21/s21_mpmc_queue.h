@@ -0,0 +1,210 @@
+#include "s21_cache_line.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+namespace s21 {
+// Bounded lock-free queue for any number of producer and consumer threads,
+// after Dmitry Vyukov's design. Every cell carries a sequence number that
+// says whose turn it is: a cell at position p is free for the producer
+// claiming p when its sequence is p, and holds a value for the consumer
+// claiming p when its sequence is p + 1. Claiming a position is one CAS on
+// the shared enqueue or dequeue counter; the handoff itself is the release
+// store of the cell's next sequence number.
+//
+// A claimed cell cannot be given back, so moving T in or out must not
+// throw.
+template <typename T> class mpmc_queue {
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_assignable_v<T>,
+                "mpmc_queue needs a T that moves without throwing");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  struct cell {
+    std::atomic<size_type> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *value() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+  };
+
+  alignas(cache_line_size) std::atomic<size_type> enqueue_pos_{0};
+  alignas(cache_line_size) std::atomic<size_type> dequeue_pos_{0};
+  alignas(cache_line_size) cell *cells_ = nullptr;
+  size_type mask_ = 0;
+
+  static size_type round_up(size_type n) noexcept {
+    size_type capacity = 1;
+    while (capacity < n) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  static std::intptr_t lag(size_type sequence, size_type expected) noexcept {
+    return static_cast<std::intptr_t>(sequence - expected);
+  }
+
+  // Claims up to `wanted` consecutive positions from `counter`. `ahead` is 0
+  // for producers, which need cells whose sequence equals the position, and
+  // 1 for consumers, which need it one past. Returns the first claimed
+  // position and stores the count in `claimed` (0 when nothing is ready).
+  size_type claim(std::atomic<size_type> &counter, size_type ahead,
+                  size_type wanted, size_type &claimed) noexcept {
+    size_type pos = counter.load(std::memory_order_relaxed);
+    while (true) {
+      size_type ready = 0;
+      while (ready < wanted) {
+        cell &c = cells_[(pos + ready) & mask_];
+        std::intptr_t diff = lag(c.sequence.load(std::memory_order_acquire),
+                                 pos + ready + ahead);
+        if (diff != 0) {
+          if (ready == 0 && diff > 0) {
+            // Another thread claimed this position first; catch up.
+            pos = counter.load(std::memory_order_relaxed);
+            continue;
+          }
+          break;
+        }
+        ++ready;
+      }
+      if (ready == 0) {
+        claimed = 0;
+        return pos;
+      }
+      if (counter.compare_exchange_weak(pos, pos + ready,
+                                        std::memory_order_relaxed)) {
+        claimed = ready;
+        return pos;
+      }
+    }
+  }
+
+public:
+  // Capacity is rounded up to a power of two; at least two cells are kept so
+  // a free cell and a filled one never share a sequence number.
+  explicit mpmc_queue(size_type capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument(
+          "Mpmc queue. Capacity must be greater than zero.");
+    }
+    size_type rounded = round_up(capacity < 2 ? 2 : capacity);
+    cells_ = static_cast<cell *>(::operator new(rounded * sizeof(cell)));
+    for (size_type i = 0; i < rounded; ++i) {
+      new (&cells_[i].sequence) std::atomic<size_type>(i);
+    }
+    mask_ = rounded - 1;
+  }
+
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  // All threads must be done with the queue.
+  ~mpmc_queue() {
+    size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type i = dequeue_pos_.load(std::memory_order_relaxed); i != tail;
+         ++i) {
+      cells_[i & mask_].value()->~T();
+    }
+    ::operator delete(cells_);
+  }
+
+  // Returns false, leaving the arguments untouched, when the queue is full.
+  // A T that may throw while being built is built before a cell is claimed
+  // and then moved in.
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args &&...>) {
+      size_type claimed;
+      size_type pos = claim(enqueue_pos_, 0, 1, claimed);
+      if (claimed == 0) {
+        return false;
+      }
+      cell &c = cells_[pos & mask_];
+      new (c.storage) T(std::forward<Args>(args)...);
+      c.sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    } else {
+      return try_emplace(T(std::forward<Args>(args)...));
+    }
+  }
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  // Claims as many consecutive cells as are free, up to the length of
+  // [first, last), with a single CAS and fills them; returns how many
+  // elements were pushed.
+  template <typename ForwardIt>
+  size_type try_push_batch(ForwardIt first, ForwardIt last) {
+    using reference = typename std::iterator_traits<ForwardIt>::reference;
+    size_type wanted = static_cast<size_type>(std::distance(first, last));
+    if constexpr (!std::is_nothrow_constructible_v<T, reference>) {
+      size_type pushed = 0;
+      for (; first != last && try_push(*first); ++first) {
+        ++pushed;
+      }
+      return pushed;
+    } else {
+      if (wanted == 0) {
+        return 0;
+      }
+      size_type claimed;
+      size_type pos = claim(enqueue_pos_, 0, wanted, claimed);
+      for (size_type i = 0; i < claimed; ++i, ++first) {
+        cell &c = cells_[(pos + i) & mask_];
+        new (c.storage) T(*first);
+        c.sequence.store(pos + i + 1, std::memory_order_release);
+      }
+      return claimed;
+    }
+  }
+
+  // Moves the front element into `out`; returns false when the queue is
+  // empty.
+  bool try_pop(T &out) noexcept { return try_pop_batch(&out, 1) == 1; }
+
+  // Claims up to `max` consecutive filled cells with a single CAS and moves
+  // their values to `out`; returns how many were popped. Writing to `out`
+  // must not throw, so reserve room in a growing destination beforehand.
+  template <typename OutputIt>
+  size_type try_pop_batch(OutputIt out, size_type max) {
+    if (max == 0) {
+      return 0;
+    }
+    size_type claimed;
+    size_type pos = claim(dequeue_pos_, 1, max, claimed);
+    for (size_type i = 0; i < claimed; ++i, ++out) {
+      cell &c = cells_[(pos + i) & mask_];
+      T *value = c.value();
+      *out = std::move(*value);
+      value->~T();
+      c.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+    }
+    return claimed;
+  }
+
+  // A snapshot that may be stale by the time it returns.
+  size_type size_approx() const noexcept {
+    size_type head = dequeue_pos_.load(std::memory_order_acquire);
+    size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const noexcept { return size_approx() == 0; }
+  size_type capacity() const noexcept { return mask_ + 1; }
+};
+
+}
+
+#endif
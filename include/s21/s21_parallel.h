@@ -0,0 +1,501 @@
+#include "s21_cache_line.h"
+#include "s21_vector.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+namespace s21 {
+namespace parallel {
+// Fork-join thread pool with work stealing. Each worker owns a deque of
+// tasks: it pushes and pops its own work at the back, which keeps the most
+// recently split (and still cached) piece local, and when it runs dry it
+// steals the oldest, largest piece from the front of another deque.
+// Threads outside the pool push into one extra shared deque.
+//
+// The only way to hand the pool work is invoke(a, b), which runs `a` and
+// `b` potentially in parallel and returns when both are done. A thread
+// waiting in invoke() runs other queued tasks meanwhile, so nested
+// invocations never starve the pool.
+class thread_pool {
+public:
+  using size_type = std::size_t;
+
+  // `threads` counts the calling thread, which takes part in every
+  // invoke(): a pool of 1 runs everything on the caller.
+  explicit thread_pool(size_type threads = std::thread::hardware_concurrency())
+      : workers_(threads > 1 ? threads - 1 : 0),
+        queues_(std::make_unique<queue[]>(workers_ + 1)) {
+    threads_.reserve(workers_);
+    for (size_type i = 0; i < workers_; ++i) {
+      threads_.emplace_back([this, i] { work(i); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &thread : threads_) {
+      thread.join();
+    }
+  }
+
+  // Number of threads that run tasks, the caller of invoke() included.
+  size_type concurrency() const noexcept { return workers_ + 1; }
+
+  // Runs `a` on this thread and offers `b` to the pool, then helps with
+  // queued work until `b` has finished. If either throws, the exception is
+  // rethrown once both are done (the one from `a` when both throw).
+  template <typename A, typename B> void invoke(A &&a, B &&b) {
+    std::atomic<bool> done{false};
+    std::exception_ptr a_error;
+    std::exception_ptr b_error;
+    auto run_b = [&] {
+      try {
+        b();
+      } catch (...) {
+        b_error = std::current_exception();
+      }
+      done.store(true, std::memory_order_release);
+    };
+    if (workers_ > 0) {
+      push(run_b);
+    }
+    try {
+      a();
+    } catch (...) {
+      a_error = std::current_exception();
+    }
+    if (workers_ == 0) {
+      run_b();
+    }
+    std::function<void()> task;
+    while (!done.load(std::memory_order_acquire)) {
+      if (take(task)) {
+        task();
+        task = nullptr;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    if (a_error) {
+      std::rethrow_exception(a_error);
+    }
+    if (b_error) {
+      std::rethrow_exception(b_error);
+    }
+  }
+
+private:
+  // Workers lock their own queues; keep each on its own cache line.
+  struct alignas(cache_line_size) queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  size_type workers_;
+  std::unique_ptr<queue[]> queues_;
+  std::vector<std::thread> threads_;
+  alignas(cache_line_size) std::atomic<size_type> pending_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+
+  static inline thread_local const thread_pool *current_pool_ = nullptr;
+  static inline thread_local size_type current_index_ = 0;
+
+  // The calling thread's own deque; the shared one for outside threads.
+  size_type own_queue() const noexcept {
+    return current_pool_ == this ? current_index_ : workers_;
+  }
+
+  void push(std::function<void()> task) {
+    queue &q = queues_[own_queue()];
+    {
+      std::lock_guard<std::mutex> lock(q.mutex);
+      q.tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+  }
+
+  // Pops the newest task of the own deque, or steals the oldest one of
+  // another.
+  bool take(std::function<void()> &task) {
+    size_type own = own_queue();
+    for (size_type i = 0; i <= workers_; ++i) {
+      queue &q = queues_[(own + i) % (workers_ + 1)];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (q.tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+      } else {
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+      }
+      pending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  void work(size_type index) {
+    current_pool_ = this;
+    current_index_ = index;
+    std::function<void()> task;
+    while (true) {
+      if (take(task)) {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [this] {
+        return stop_ || pending_.load(std::memory_order_relaxed) > 0;
+      });
+      if (stop_ && pending_.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+};
+
+// Pool used by the algorithms called without one, sized to the machine.
+inline thread_pool &default_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+namespace detail {
+// Elements per chunk: 64 KiB worth, so a chunk and its output stay in L2
+// while a core works on it and one task does enough work to amortize
+// scheduling, rounded to whole cache lines so neighbouring chunks rarely
+// share one.
+inline constexpr std::size_t chunk_bytes = std::size_t{64} << 10;
+// Sort leaves of 256 KiB are sorted with std::sort in cache.
+inline constexpr std::size_t sort_leaf_bytes = std::size_t{256} << 10;
+
+template <typename T> constexpr std::size_t grain() noexcept {
+  std::size_t line =
+      sizeof(T) < cache_line_size ? cache_line_size / sizeof(T) : 1;
+  std::size_t n = chunk_bytes / sizeof(T);
+  return n < line ? line : n / line * line;
+}
+
+template <typename Body>
+void split_chunks(thread_pool &pool, std::size_t first_chunk,
+                  std::size_t last_chunk, std::size_t n, std::size_t grain,
+                  const Body &body) {
+  if (last_chunk - first_chunk == 1) {
+    std::size_t begin = first_chunk * grain;
+    body(first_chunk, begin, std::min(n, begin + grain));
+    return;
+  }
+  std::size_t mid = first_chunk + (last_chunk - first_chunk) / 2;
+  pool.invoke(
+      [&] { split_chunks(pool, first_chunk, mid, n, grain, body); },
+      [&] { split_chunks(pool, mid, last_chunk, n, grain, body); });
+}
+
+// Calls body(chunk, begin, end) for every chunk [begin, end) of `grain`
+// indices in [0, n), splitting the range in halves across the pool. Chunk
+// boundaries depend on `n` and `grain` only, never on the thread count.
+template <typename Body>
+std::size_t for_chunks(thread_pool &pool, std::size_t n, std::size_t grain,
+                       const Body &body) {
+  std::size_t chunks = (n + grain - 1) / grain;
+  if (chunks > 0) {
+    split_chunks(pool, 0, chunks, n, grain, body);
+  }
+  return chunks;
+}
+
+// Stable merge of two sorted runs into `out`, moving the elements. The
+// larger run is halved and the other split where its middle element would
+// go, and both halves are merged in parallel.
+template <typename In, typename Out, typename Compare>
+void merge(thread_pool &pool, In first1, In last1, In first2, In last2,
+           Out out, std::size_t grain, Compare &comp) {
+  auto n1 = last1 - first1;
+  auto n2 = last2 - first2;
+  if (static_cast<std::size_t>(n1 + n2) <= grain) {
+    std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+               std::make_move_iterator(first2), std::make_move_iterator(last2),
+               out, comp);
+    return;
+  }
+  In mid1, mid2;
+  if (n1 >= n2) {
+    mid1 = first1 + n1 / 2;
+    mid2 = std::lower_bound(first2, last2, *mid1, comp);
+  } else {
+    mid2 = first2 + n2 / 2;
+    mid1 = std::upper_bound(first1, last1, *mid2, comp);
+  }
+  Out out_mid = out + (mid1 - first1) + (mid2 - first2);
+  pool.invoke(
+      [&] { merge(pool, first1, mid1, first2, mid2, out, grain, comp); },
+      [&] { merge(pool, mid1, last1, mid2, last2, out_mid, grain, comp); });
+}
+
+// Sorts the `n` elements at `a`, leaving the result at `b` when `to_b` is
+// set and at `a` otherwise; the other array is scratch space. The halves
+// are sorted into the opposite array so every level merges once and no
+// pass copies back.
+template <typename A, typename B, typename Compare>
+void merge_sort(thread_pool &pool, A a, B b, std::size_t n, bool to_b,
+                std::size_t leaf, std::size_t grain, Compare &comp) {
+  if (n <= leaf) {
+    std::sort(a, a + n, comp);
+    if (to_b) {
+      std::move(a, a + n, b);
+    }
+    return;
+  }
+  std::size_t half = n / 2;
+  pool.invoke(
+      [&] { merge_sort(pool, a, b, half, !to_b, leaf, grain, comp); },
+      [&] {
+        merge_sort(pool, a + half, b + half, n - half, !to_b, leaf, grain,
+                   comp);
+      });
+  if (to_b) {
+    merge(pool, a, a + half, a + half, a + n, b, grain, comp);
+  } else {
+    merge(pool, b, b + half, b + half, b + n, a, grain, comp);
+  }
+}
+}
+
+// The algorithms below mirror their std:: namesakes over random-access
+// ranges such as s21::vector's, and take the pool to run on as an optional
+// first argument. Ranges are cut into cache-sized chunks whose boundaries
+// do not depend on the number of threads, and partial results are combined
+// in chunk order, so reduce and inclusive_scan return the same value on
+// every run and every pool, floating point included. Exceptions thrown by
+// the callables are rethrown to the caller after all running chunks have
+// finished; the output is then left partially written.
+
+template <std::random_access_iterator It, typename F>
+void for_each(thread_pool &pool, It first, It last, F f) {
+  detail::for_chunks(pool, static_cast<std::size_t>(last - first),
+                     detail::grain<std::iter_value_t<It>>(),
+                     [&](std::size_t, std::size_t begin, std::size_t end) {
+                       std::for_each(first + begin, first + end, f);
+                     });
+}
+
+template <std::random_access_iterator It, typename F>
+void for_each(It first, It last, F f) {
+  parallel::for_each(default_pool(), first, last, std::move(f));
+}
+
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename UnaryOp>
+Out transform(thread_pool &pool, It first, It last, Out d_first, UnaryOp op) {
+  std::size_t n = static_cast<std::size_t>(last - first);
+  detail::for_chunks(pool, n, detail::grain<std::iter_value_t<It>>(),
+                     [&](std::size_t, std::size_t begin, std::size_t end) {
+                       std::transform(first + begin, first + end,
+                                      d_first + begin, op);
+                     });
+  return d_first + n;
+}
+
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename UnaryOp>
+Out transform(It first, It last, Out d_first, UnaryOp op) {
+  return parallel::transform(default_pool(), first, last, d_first,
+                             std::move(op));
+}
+
+// Folds every chunk from its first element, then folds `init` with the
+// chunk results in order. `op` must be associative; unlike std::reduce it
+// need not be commutative.
+template <std::random_access_iterator It, typename T,
+          typename BinaryOp = std::plus<>>
+T reduce(thread_pool &pool, It first, It last, T init, BinaryOp op = {}) {
+  std::size_t n = static_cast<std::size_t>(last - first);
+  std::size_t grain = detail::grain<std::iter_value_t<It>>();
+  vector<std::optional<T>> partial((n + grain - 1) / grain);
+  detail::for_chunks(pool, n, grain,
+                     [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                       T acc = first[begin];
+                       for (std::size_t i = begin + 1; i < end; ++i) {
+                         acc = op(std::move(acc), first[i]);
+                       }
+                       partial[chunk].emplace(std::move(acc));
+                     });
+  for (std::optional<T> &value : partial) {
+    init = op(std::move(init), std::move(*value));
+  }
+  return init;
+}
+
+template <std::random_access_iterator It, typename T,
+          typename BinaryOp = std::plus<>>
+T reduce(It first, It last, T init, BinaryOp op = {}) {
+  return parallel::reduce(default_pool(), first, last, std::move(init),
+                          std::move(op));
+}
+
+template <std::random_access_iterator It>
+std::iter_value_t<It> reduce(thread_pool &pool, It first, It last) {
+  return parallel::reduce(pool, first, last, std::iter_value_t<It>{});
+}
+
+template <std::random_access_iterator It>
+std::iter_value_t<It> reduce(It first, It last) {
+  return parallel::reduce(default_pool(), first, last);
+}
+
+// Three passes: every chunk is reduced, the chunk totals are scanned in
+// order on the calling thread, and every chunk is scanned again starting
+// from the total of the chunks before it. `op` must be associative. The
+// output may be the input itself.
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename BinaryOp = std::plus<>>
+Out inclusive_scan(thread_pool &pool, It first, It last, Out d_first,
+                   BinaryOp op = {}) {
+  using T = std::iter_value_t<It>;
+  std::size_t n = static_cast<std::size_t>(last - first);
+  std::size_t grain = detail::grain<T>();
+  std::size_t chunks = (n + grain - 1) / grain;
+  if (chunks <= 1) {
+    return std::inclusive_scan(first, last, d_first, op);
+  }
+  vector<std::optional<T>> carry(chunks);
+  detail::for_chunks(pool, n - (n - 1) % grain - 1, grain,
+                     [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                       T acc = first[begin];
+                       for (std::size_t i = begin + 1; i < end; ++i) {
+                         acc = op(std::move(acc), first[i]);
+                       }
+                       carry[chunk + 1].emplace(std::move(acc));
+                     });
+  for (std::size_t chunk = 2; chunk < chunks; ++chunk) {
+    T total = op(*carry[chunk - 1], std::move(*carry[chunk]));
+    *carry[chunk] = std::move(total);
+  }
+  detail::for_chunks(pool, n, grain,
+                     [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                       if (chunk == 0) {
+                         std::inclusive_scan(first, first + end, d_first, op);
+                       } else {
+                         std::inclusive_scan(first + begin, first + end,
+                                             d_first + begin, op,
+                                             std::move(*carry[chunk]));
+                       }
+                     });
+  return d_first + n;
+}
+
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename BinaryOp = std::plus<>>
+Out inclusive_scan(It first, It last, Out d_first, BinaryOp op = {}) {
+  return parallel::inclusive_scan(default_pool(), first, last, d_first,
+                                  std::move(op));
+}
+
+// Stable: the kept elements keep their order. `pred` runs once per element;
+// its answers are kept in a byte per element while every chunk's count
+// decides where the chunk's output starts.
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename Predicate>
+Out copy_if(thread_pool &pool, It first, It last, Out d_first,
+            Predicate pred) {
+  std::size_t n = static_cast<std::size_t>(last - first);
+  std::size_t grain = detail::grain<std::iter_value_t<It>>();
+  if (n <= grain || pool.concurrency() == 1) {
+    return std::copy_if(first, last, d_first, pred);
+  }
+  vector<unsigned char> keep(n);
+  vector<std::size_t> offset((n + grain - 1) / grain + 1);
+  detail::for_chunks(pool, n, grain,
+                     [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                       std::size_t kept = 0;
+                       for (std::size_t i = begin; i < end; ++i) {
+                         keep[i] = pred(first[i]) ? 1 : 0;
+                         kept += keep[i];
+                       }
+                       offset[chunk + 1] = kept;
+                     });
+  for (std::size_t chunk = 1; chunk < offset.size(); ++chunk) {
+    offset[chunk] += offset[chunk - 1];
+  }
+  detail::for_chunks(pool, n, grain,
+                     [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                       Out out = d_first + offset[chunk];
+                       for (std::size_t i = begin; i < end; ++i) {
+                         if (keep[i]) {
+                           *out++ = first[i];
+                         }
+                       }
+                     });
+  return d_first + offset.back();
+}
+
+template <std::random_access_iterator It, std::random_access_iterator Out,
+          typename Predicate>
+Out copy_if(It first, It last, Out d_first, Predicate pred) {
+  return parallel::copy_if(default_pool(), first, last, d_first,
+                           std::move(pred));
+}
+
+// Parallel merge sort: leaves of 256 KiB are sorted with std::sort, then
+// merged level by level, each merge itself split across the pool. Needs a
+// scratch buffer the size of the range. Not stable, like std::sort; use a
+// comparator that orders equal elements if a fixed order matters. If
+// `comp` throws, the range is left with some elements moved from.
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void sort(thread_pool &pool, It first, It last, Compare comp = {}) {
+  using T = std::iter_value_t<It>;
+  std::size_t n = static_cast<std::size_t>(last - first);
+  std::size_t leaf = std::max<std::size_t>(detail::sort_leaf_bytes / sizeof(T),
+                                           detail::grain<T>());
+  if (n <= leaf || pool.concurrency() == 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+  vector<T> scratch;
+  scratch.reserve(n);
+  scratch.assign(std::make_move_iterator(first), std::make_move_iterator(last));
+  detail::merge_sort(pool, scratch.begin(), first, n, true, leaf,
+                     detail::grain<T>(), comp);
+}
+
+template <std::random_access_iterator It, typename Compare = std::less<>>
+void sort(It first, It last, Compare comp = {}) {
+  parallel::sort(default_pool(), first, last, std::move(comp));
+}
+}
+
+}
+
+#endif
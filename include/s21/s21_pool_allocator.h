@@ -0,0 +1,324 @@
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+namespace s21 {
+namespace detail {
+// The memory behind a group of pool_allocators that compare equal: one pool
+// per block size and alignment, so allocators rebound to different types
+// share the arena and each carves blocks from the pool that fits it.
+class pool_arena {
+public:
+  using size_type = std::size_t;
+
+  // Single-object blocks carved from geometrically growing chunks and
+  // recycled through an intrusive free list.
+  class pool {
+  public:
+    pool(size_type size, size_type align, pool *next_pool) noexcept
+        : block_size(size), block_align(align),
+          header_size(round_up(sizeof(void *), align)), next(next_pool) {}
+    pool(const pool &) = delete;
+    pool &operator=(const pool &) = delete;
+    ~pool() { release(); }
+
+    void *allocate() {
+      if (free_list) {
+        void *block = free_list;
+        free_list = *static_cast<void **>(block);
+        return block;
+      }
+      if (cursor == limit) {
+        add_chunk();
+      }
+      void *block = cursor;
+      cursor += block_size;
+      return block;
+    }
+
+    void deallocate(void *block) noexcept {
+      *static_cast<void **>(block) = free_list;
+      free_list = block;
+    }
+
+    void add_chunk() { add_chunk(next_blocks); }
+
+    void add_chunk(size_type blocks) {
+      for (; cursor != limit; cursor += block_size) {
+        deallocate(cursor);
+      }
+      size_type bytes = header_size + blocks * block_size;
+      char *chunk = static_cast<char *>(
+          ::operator new(bytes, std::align_val_t(block_align)));
+      *reinterpret_cast<void **>(chunk) = chunks;
+      chunks = chunk;
+      cursor = chunk + header_size;
+      limit = chunk + bytes;
+      if (next_blocks < max_chunk_blocks) {
+        next_blocks *= 2;
+      }
+    }
+
+    // Blocks left in the current chunk.
+    size_type left() const noexcept {
+      return static_cast<size_type>(limit - cursor) / block_size;
+    }
+
+    size_type next_chunk_blocks() const noexcept { return next_blocks; }
+
+    // Takes over every chunk and free block of `other`, which has the same
+    // block size and alignment, leaving it empty.
+    void absorb(pool &other) noexcept {
+      while (other.free_list) {
+        void *block = other.free_list;
+        other.free_list = *static_cast<void **>(block);
+        deallocate(block);
+      }
+      for (; other.cursor != other.limit; other.cursor += block_size) {
+        deallocate(other.cursor);
+      }
+      while (other.chunks) {
+        void *chunk = other.chunks;
+        other.chunks = *static_cast<void **>(chunk);
+        *static_cast<void **>(chunk) = chunks;
+        chunks = chunk;
+      }
+      other.cursor = nullptr;
+      other.limit = nullptr;
+    }
+
+    void release() noexcept {
+      while (chunks) {
+        void *next_chunk = *static_cast<void **>(chunks);
+        ::operator delete(chunks, std::align_val_t(block_align));
+        chunks = next_chunk;
+      }
+      free_list = nullptr;
+      cursor = nullptr;
+      limit = nullptr;
+      next_blocks = first_chunk_blocks;
+    }
+
+  private:
+    friend class pool_arena;
+
+    static constexpr size_type first_chunk_blocks = 64;
+    static constexpr size_type max_chunk_blocks = 8192;
+
+    size_type block_size;
+    size_type block_align;
+    size_type header_size;
+    pool *next;
+    void *chunks = nullptr;
+    void *free_list = nullptr;
+    char *cursor = nullptr;
+    char *limit = nullptr;
+    size_type next_blocks = first_chunk_blocks;
+  };
+
+  static constexpr size_type round_up(size_type n, size_type align) {
+    return (n + align - 1) / align * align;
+  }
+
+  pool_arena() noexcept = default;
+  pool_arena(const pool_arena &) = delete;
+  pool_arena &operator=(const pool_arena &) = delete;
+  ~pool_arena() {
+    while (pools_) {
+      pool *next = pools_->next;
+      delete pools_;
+      pools_ = next;
+    }
+  }
+
+  pool *find(size_type size, size_type align) const noexcept {
+    for (pool *p = pools_; p; p = p->next) {
+      if (p->block_size == size && p->block_align == align) {
+        return p;
+      }
+    }
+    return nullptr;
+  }
+
+  pool &get(size_type size, size_type align) {
+    if (pool *p = find(size, align)) {
+      return *p;
+    }
+    pools_ = new pool(size, align, pools_);
+    return *pools_;
+  }
+
+  void release() noexcept {
+    for (pool *p = pools_; p; p = p->next) {
+      p->release();
+    }
+  }
+
+  // Takes over the memory of every pool in `other`, leaving it empty. The
+  // pools it needs here are created first, so if that throws nothing has
+  // moved.
+  void absorb(pool_arena &other) {
+    for (pool *p = other.pools_; p; p = p->next) {
+      get(p->block_size, p->block_align);
+    }
+    for (pool *p = other.pools_; p; p = p->next) {
+      find(p->block_size, p->block_align)->absorb(*p);
+    }
+  }
+
+private:
+  pool *pools_ = nullptr;
+};
+}
+
+// Slab allocator for node-based containers. Single-object allocations are
+// carved from geometrically growing chunks and recycled through an intrusive
+// free list; release() returns every chunk at once. Array allocations go
+// straight to ::operator new.
+//
+// Allocators that compare equal share one arena with a pool per block size.
+// Copies share it, and so do allocators rebound to another type, so
+// pool_allocator<T>(pool_allocator<U>(a)) == a. The arena is created by
+// the first allocation; copies taken before that start arenas of their
+// own. A container copy gets a fresh arena through
+// select_on_container_copy_construction.
+template <typename T> class pool_allocator {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template <typename U> struct rebind {
+    using other = pool_allocator<U>;
+  };
+
+private:
+  using pool = detail::pool_arena::pool;
+
+  static constexpr size_type block_align =
+      alignof(T) > alignof(void *) ? alignof(T) : alignof(void *);
+  static constexpr size_type block_size = detail::pool_arena::round_up(
+      sizeof(T) > sizeof(void *) ? sizeof(T) : sizeof(void *), block_align);
+
+  std::shared_ptr<detail::pool_arena> arena_;
+  // arena_'s pool for this block size, once looked up.
+  pool *pool_ = nullptr;
+
+  template <typename U> friend class pool_allocator;
+
+  pool &own_pool() {
+    if (!pool_) {
+      if (!arena_) {
+        arena_ = std::make_shared<detail::pool_arena>();
+      }
+      pool_ = &arena_->get(block_size, block_align);
+    }
+    return *pool_;
+  }
+
+public:
+  pool_allocator() noexcept = default;
+  pool_allocator(const pool_allocator &other) noexcept = default;
+  pool_allocator(pool_allocator &&other) noexcept
+      : arena_(std::move(other.arena_)),
+        pool_(std::exchange(other.pool_, nullptr)) {}
+  template <typename U>
+  pool_allocator(const pool_allocator<U> &other) noexcept
+      : arena_(other.arena_) {}
+
+  pool_allocator &operator=(const pool_allocator &other) noexcept = default;
+  pool_allocator &operator=(pool_allocator &&other) noexcept {
+    arena_ = std::move(other.arena_);
+    pool_ = std::exchange(other.pool_, nullptr);
+    return *this;
+  }
+
+  pool_allocator select_on_container_copy_construction() const {
+    return pool_allocator();
+  }
+
+  T *allocate(size_type n) {
+    if (n != 1) {
+      return static_cast<T *>(
+          ::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+    return static_cast<T *>(own_pool().allocate());
+  }
+
+  // `p` must come from an allocator equal to this one. A default-constructed
+  // or moved-from allocator has no arena and so never handed out a block.
+  void deallocate(T *p, size_type n) noexcept {
+    if (n != 1) {
+      ::operator delete(p, std::align_val_t(alignof(T)));
+      return;
+    }
+    if (!pool_ && arena_) {
+      pool_ = arena_->find(block_size, block_align);
+    }
+    assert(pool_ && "pool_allocator: block freed through an allocator "
+                    "without a pool");
+    pool_->deallocate(p);
+  }
+
+  // Returns every chunk of every pool in the arena to the system in
+  // O(chunks). Objects still living in the arena must already be destroyed;
+  // pointers into it become dangling.
+  void release() noexcept {
+    if (arena_) {
+      arena_->release();
+    }
+  }
+
+  // Makes sure the next `n` blocks carved from fresh memory are contiguous,
+  // starting a chunk of at least `n` blocks if the current one is too short.
+  void reserve(size_type n) {
+    pool &p = own_pool();
+    if (p.left() < n) {
+      p.add_chunk(n > p.next_chunk_blocks() ? n : p.next_chunk_blocks());
+    }
+  }
+
+  // True when no other allocator shares this arena, so release() cannot
+  // pull memory out from under someone else.
+  bool owns_pool() const noexcept { return !arena_ || arena_.use_count() == 1; }
+
+  // Merges `other`'s arena into this one and makes both allocators share
+  // it, so blocks from either may be freed through either. Refused
+  // (returning false) when `other`'s arena is shared, since its other
+  // owners would keep an arena that no longer owns its memory.
+  bool adopt(pool_allocator &other) {
+    if (arena_ == other.arena_) {
+      return true;
+    }
+    if (!other.owns_pool()) {
+      return false;
+    }
+    if (!arena_) {
+      arena_ = std::make_shared<detail::pool_arena>();
+    }
+    if (other.arena_) {
+      arena_->absorb(*other.arena_);
+    }
+    other.arena_ = arena_;
+    other.pool_ = pool_;
+    return true;
+  }
+
+  template <typename U>
+  bool operator==(const pool_allocator<U> &other) const noexcept {
+    return arena_ == other.arena_;
+  }
+};
+
+}
+
+#endif
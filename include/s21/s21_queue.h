@@ -1,9 +1,11 @@
+#include "s21_ring_buffer.h"
 #include "s21_vector.h"
+#include <memory>
 #ifndef QUEUE_H
 #define QUEUE_H
 
 namespace s21 {
-template <typename T, typename Container = vector<T>> class queue {
+template <typename T, typename Container = ring_buffer<T>> class queue {
 private:
   Container container;
 
@@ -19,6 +21,27 @@ public:
   ~queue() {}
   queue(std::initializer_list<value_type> list) : container(list) {}
 
+  // Allocator-extended constructors, as for std::queue: `alloc` is handed to
+  // the container, so a queue over a pmr container draws from its resource.
+  template <typename Alloc>
+    requires std::uses_allocator_v<Container, Alloc>
+  explicit queue(const Alloc &alloc) : container(alloc) {}
+
+  template <typename Alloc>
+    requires std::uses_allocator_v<Container, Alloc>
+  queue(std::initializer_list<value_type> list, const Alloc &alloc)
+      : container(list, alloc) {}
+
+  template <typename Alloc>
+    requires std::uses_allocator_v<Container, Alloc>
+  queue(const queue &other, const Alloc &alloc)
+      : container(other.container, alloc) {}
+
+  template <typename Alloc>
+    requires std::uses_allocator_v<Container, Alloc>
+  queue(queue &&other, const Alloc &alloc)
+      : container(std::move(other.container), alloc) {}
+
   queue &operator=(const queue &other) {
     if (this == &other) {
       return *this;
@@ -35,7 +58,14 @@ public:
   }
 
   void push(const_reference value) { container.push_back(value); }
-  void pop() { container.erase(container.begin()); }
+  void push(value_type &&value) { container.push_back(std::move(value)); }
+  void pop() {
+    if constexpr (requires { container.pop_front(); }) {
+      container.pop_front();
+    } else {
+      container.erase(container.begin());
+    }
+  }
   void swap(queue &other) { container.swap(other.container); }
 
   size_type size() const { return container.size(); }
@@ -44,6 +74,10 @@ public:
   const_reference back() const { return container.back(); }
 };
 
+namespace pmr {
+template <typename T> using queue = s21::queue<T, pmr::ring_buffer<T>>;
+}
+
 }
 
 #endif
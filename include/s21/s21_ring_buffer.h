@@ -0,0 +1,275 @@
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+namespace s21 {
+// Growable circular buffer. Capacity is always zero or a power of two so the
+// physical slot of a logical index is a single mask. push_back and pop_front
+// are amortized O(1); growth moves elements into a buffer twice as large.
+// Storage and elements go through `Allocator`, as in s21::vector.
+template <typename T, typename Allocator = std::allocator<T>>
+class ring_buffer {
+public:
+  using value_type = T;
+  using allocator_type = Allocator;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+  using pointer = T *;
+  using const_pointer = const T *;
+
+private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::pointer, pointer>,
+                "ring_buffer needs an allocator whose pointer type is T*");
+
+  pointer data_ = nullptr;
+  size_type capacity_ = 0;
+  size_type head_ = 0;
+  size_type size_ = 0;
+  [[no_unique_address]] Allocator alloc_;
+
+  size_type slot(size_type index) const noexcept {
+    return (head_ + index) & (capacity_ - 1);
+  }
+
+  static size_type round_up(size_type n) noexcept {
+    size_type capacity = 1;
+    while (capacity < n) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  void free_storage() noexcept {
+    if (data_) {
+      alloc_traits::deallocate(alloc_, data_, capacity_);
+    }
+  }
+
+  void swap_storage(ring_buffer &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  void relocate(size_type new_capacity) {
+    pointer new_data = alloc_traits::allocate(alloc_, new_capacity);
+    size_type moved = 0;
+    try {
+      for (; moved < size_; ++moved) {
+        alloc_traits::construct(alloc_, new_data + moved,
+                                std::move_if_noexcept(data_[slot(moved)]));
+      }
+    } catch (...) {
+      for (size_type i = 0; i < moved; ++i) {
+        alloc_traits::destroy(alloc_, new_data + i);
+      }
+      alloc_traits::deallocate(alloc_, new_data, new_capacity);
+      throw;
+    }
+    for (size_type i = 0; i < size_; ++i) {
+      alloc_traits::destroy(alloc_, data_ + slot(i));
+    }
+    free_storage();
+    data_ = new_data;
+    capacity_ = new_capacity;
+    head_ = 0;
+  }
+
+  void grow_if_full() {
+    if (size_ == capacity_) {
+      relocate(capacity_ == 0 ? 1 : capacity_ * 2);
+    }
+  }
+
+public:
+  ring_buffer() noexcept(noexcept(Allocator())) = default;
+  explicit ring_buffer(const Allocator &alloc) noexcept : alloc_(alloc) {}
+
+  ring_buffer(std::initializer_list<value_type> list,
+              const Allocator &alloc = Allocator())
+      : alloc_(alloc) {
+    reserve(list.size());
+    for (const auto &item : list) {
+      push_back(item);
+    }
+  }
+
+  ring_buffer(const ring_buffer &other)
+      : ring_buffer(other,
+                    alloc_traits::select_on_container_copy_construction(
+                        other.alloc_)) {}
+
+  ring_buffer(const ring_buffer &other, const Allocator &alloc)
+      : alloc_(alloc) {
+    reserve(other.size_);
+    for (size_type i = 0; i < other.size_; ++i) {
+      push_back(other[i]);
+    }
+  }
+
+  ring_buffer(ring_buffer &&other) noexcept
+      : data_(other.data_), capacity_(other.capacity_), head_(other.head_),
+        size_(other.size_), alloc_(std::move(other.alloc_)) {
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+    other.head_ = 0;
+    other.size_ = 0;
+  }
+
+  // Takes over the buffer when `alloc` can free it; otherwise moves the
+  // elements one by one into storage from `alloc`.
+  ring_buffer(ring_buffer &&other, const Allocator &alloc) : alloc_(alloc) {
+    if (alloc_ == other.alloc_) {
+      swap_storage(other);
+    } else {
+      reserve(other.size_);
+      for (size_type i = 0; i < other.size_; ++i) {
+        push_back(std::move(other[i]));
+      }
+      other.clear();
+    }
+  }
+
+  ~ring_buffer() noexcept {
+    clear();
+    free_storage();
+  }
+
+  ring_buffer &operator=(const ring_buffer &other) {
+    using propagate = alloc_traits::propagate_on_container_copy_assignment;
+    if (this != &other) {
+      ring_buffer copy(other, propagate::value ? other.alloc_ : alloc_);
+      swap_storage(copy);
+      if constexpr (propagate::value) {
+        using std::swap;
+        swap(alloc_, copy.alloc_);
+      }
+    }
+    return *this;
+  }
+
+  ring_buffer &operator=(ring_buffer &&other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    using propagate = alloc_traits::propagate_on_container_move_assignment;
+    if (this != &other) {
+      ring_buffer moved(std::move(other),
+                        propagate::value ? other.alloc_ : alloc_);
+      swap_storage(moved);
+      if constexpr (propagate::value) {
+        using std::swap;
+        swap(alloc_, moved.alloc_);
+      }
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  void reserve(size_type new_capacity) {
+    if (new_capacity > capacity_) {
+      relocate(round_up(new_capacity));
+    }
+  }
+
+  void clear() noexcept {
+    for (size_type i = 0; i < size_; ++i) {
+      alloc_traits::destroy(alloc_, data_ + slot(i));
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      // The argument may alias an element, so build it before relocating.
+      value_type tmp(std::forward<Args>(args)...);
+      grow_if_full();
+      alloc_traits::construct(alloc_, data_ + slot(size_), std::move(tmp));
+    } else {
+      alloc_traits::construct(alloc_, data_ + slot(size_),
+                              std::forward<Args>(args)...);
+    }
+    return data_[slot(size_++)];
+  }
+
+  void pop_front() {
+    if (size_ == 0) {
+      throw std::runtime_error(
+          "Pop front. The size is zero, you can't remove anything.");
+    }
+    alloc_traits::destroy(alloc_, data_ + head_);
+    head_ = (head_ + 1) & (capacity_ - 1);
+    --size_;
+  }
+
+  // Allocators are exchanged only when the traits say they propagate on
+  // swap; otherwise they must compare equal.
+  void swap(ring_buffer &other) noexcept {
+    swap_storage(other);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+  }
+
+  reference operator[](size_type index) { return data_[slot(index)]; }
+  const_reference operator[](size_type index) const {
+    return data_[slot(index)];
+  }
+
+  reference front() {
+    if (size_ == 0) {
+      throw std::out_of_range(
+          "Front. The size is zero, you can't get anything.");
+    }
+    return data_[head_];
+  }
+  const_reference front() const {
+    if (size_ == 0) {
+      throw std::out_of_range(
+          "Front. The size is zero, you can't get anything.");
+    }
+    return data_[head_];
+  }
+  reference back() {
+    if (size_ == 0) {
+      throw std::out_of_range(
+          "Back. The size is zero, you can't get anything.");
+    }
+    return data_[slot(size_ - 1)];
+  }
+  const_reference back() const {
+    if (size_ == 0) {
+      throw std::out_of_range(
+          "Back. The size is zero, you can't get anything.");
+    }
+    return data_[slot(size_ - 1)];
+  }
+
+  size_type size() const noexcept { return size_; }
+  size_type capacity() const noexcept { return capacity_; }
+  bool empty() const noexcept { return size_ == 0; }
+};
+
+namespace pmr {
+template <typename T>
+using ring_buffer = s21::ring_buffer<T, std::pmr::polymorphic_allocator<T>>;
+}
+
+}
+
+#endif
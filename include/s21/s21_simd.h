@@ -0,0 +1,339 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_SIMD_X86 1
+#endif
+
+namespace s21 {
+// Vectorized linear scans over arrays of arithmetic values: find, count,
+// minmax and mismatch (which equality and ordering are built on).
+//
+// Every kernel is written once with GCC/Clang vector extensions over W-byte
+// vectors and compiled for three x86 levels: SSE2 (16 bytes, the x86-64
+// baseline), AVX2 (32) and AVX-512 (64, which needs AVX512BW for byte
+// lanes). The level is picked at run time from the CPU, so one binary runs
+// the widest kernels the machine has. On other architectures the scalar
+// loops are used and left to the compiler's auto-vectorizer.
+//
+// Results match the scalar loops exactly: elements are compared with ==
+// and <, so a NaN never equals anything, and +0.0 equals -0.0.
+namespace simd {
+template <typename T>
+concept vectorizable =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+enum class level { scalar, sse2, avx2, avx512 };
+
+// The widest level this CPU supports.
+inline level detected_level() noexcept {
+  static const level best = [] {
+#ifdef S21_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+      return level::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return level::avx2;
+    }
+    return level::sse2;
+#else
+    return level::scalar;
+#endif
+  }();
+  return best;
+}
+
+namespace detail {
+inline std::atomic<level> &current_level() noexcept {
+  static std::atomic<level> current{detected_level()};
+  return current;
+}
+}
+
+// The level the kernels run at: detected_level() unless lowered with
+// set_level(), e.g. to compare levels in tests and benchmarks.
+inline level active_level() noexcept {
+  return detail::current_level().load(std::memory_order_relaxed);
+}
+
+// Requests a level; one above detected_level() is lowered to it.
+inline void set_level(level wanted) noexcept {
+  level best = detected_level();
+  detail::current_level().store(wanted > best ? best : wanted,
+                                std::memory_order_relaxed);
+}
+
+namespace detail {
+template <std::size_t Size> struct lane_int;
+template <> struct lane_int<1> { using type = std::int8_t; };
+template <> struct lane_int<2> { using type = std::int16_t; };
+template <> struct lane_int<4> { using type = std::int32_t; };
+template <> struct lane_int<8> { using type = std::int64_t; };
+
+// Vector types of W bytes over T: `vec` for values, `unaligned` to load
+// them from any address, `mask` for comparison results (all ones where
+// true) and `counter` for per-lane match counts.
+template <typename T, std::size_t W> struct lanes {
+  using mask_lane = typename lane_int<sizeof(T)>::type;
+  using counter_lane = std::make_unsigned_t<mask_lane>;
+  typedef T vec __attribute__((vector_size(W)));
+  typedef T unaligned __attribute__((vector_size(W), aligned(1), may_alias));
+  typedef mask_lane mask __attribute__((vector_size(W)));
+  typedef counter_lane counter __attribute__((vector_size(W)));
+  typedef std::uint64_t words __attribute__((vector_size(W)));
+  static constexpr std::size_t count = W / sizeof(T);
+};
+
+// A view of the W bytes at `p`. Returned by reference so that no wide
+// vector crosses a function boundary.
+template <typename L, typename T>
+[[gnu::always_inline]] inline const typename L::unaligned &
+load(const T *p) noexcept {
+  return *reinterpret_cast<const typename L::unaligned *>(p);
+}
+
+// Whether any lane of the masks is set. The masks are combined as 64-bit
+// words: GCC scalarizes an | of 512-bit comparison results built under
+// target("avx512f") instead of keeping it in vector registers.
+template <typename L, typename... Masks>
+[[gnu::always_inline]] inline bool any(const Masks &...m) noexcept {
+  typename L::words w = ((typename L::words)m | ...);
+  std::uint64_t bits = 0;
+  for (std::size_t k = 0; k < sizeof(w) / 8; ++k) {
+    bits |= w[k];
+  }
+  return bits != 0;
+}
+
+// Each kernel has a scalar loop and a run<W>() over W-byte vectors that
+// handles groups of four vectors, then single vectors, and leaves the last
+// partial vector to the scalar code.
+template <typename T> struct find_kernel {
+  static std::size_t scalar(const T *p, std::size_t n, T value) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (p[i] == value) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  template <std::size_t W>
+  [[gnu::always_inline]] static std::size_t run(const T *p, std::size_t n,
+                                                T value) noexcept {
+    using L = lanes<T, W>;
+    using V = typename L::vec;
+    constexpr std::size_t step = 4 * L::count;
+    V needle = V{} + value;
+    std::size_t i = 0;
+    for (; i + step <= n; i += step) {
+      if (any<L>(load<L>(p + i) == needle,
+                 load<L>(p + i + L::count) == needle,
+                 load<L>(p + i + 2 * L::count) == needle,
+                 load<L>(p + i + 3 * L::count) == needle)) {
+        break;
+      }
+    }
+    for (; i + L::count <= n; i += L::count) {
+      if (any<L>(load<L>(p + i) == needle)) {
+        break;
+      }
+    }
+    return i + scalar(p + i, n - i, value);
+  }
+};
+
+template <typename T> struct count_kernel {
+  static std::size_t scalar(const T *p, std::size_t n, T value) noexcept {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      total += p[i] == value;
+    }
+    return total;
+  }
+
+  // Lanes count matches by subtracting the all-ones mask; they are added
+  // up before a narrow lane could wrap.
+  template <std::size_t W>
+  [[gnu::always_inline]] static std::size_t run(const T *p, std::size_t n,
+                                                T value) noexcept {
+    using L = lanes<T, W>;
+    using V = typename L::vec;
+    using C = typename L::counter;
+    constexpr std::size_t step = 4 * L::count;
+    constexpr std::size_t max_rounds =
+        std::numeric_limits<typename L::counter_lane>::max() / 4 < (1u << 20)
+            ? std::numeric_limits<typename L::counter_lane>::max() / 4
+            : (1u << 20);
+    V needle = V{} + value;
+    std::size_t total = 0;
+    std::size_t i = 0;
+    while (i + step <= n) {
+      C acc{};
+      for (std::size_t round = 0; round < max_rounds && i + step <= n;
+           ++round, i += step) {
+        acc -= (C)(load<L>(p + i) == needle);
+        acc -= (C)(load<L>(p + i + L::count) == needle);
+        acc -= (C)(load<L>(p + i + 2 * L::count) == needle);
+        acc -= (C)(load<L>(p + i + 3 * L::count) == needle);
+      }
+      for (std::size_t k = 0; k < L::count; ++k) {
+        total += acc[k];
+      }
+    }
+    C rest{};
+    for (; i + L::count <= n; i += L::count) {
+      rest -= (C)(load<L>(p + i) == needle);
+    }
+    for (std::size_t k = 0; k < L::count; ++k) {
+      total += rest[k];
+    }
+    return total + scalar(p + i, n - i, value);
+  }
+};
+
+template <typename T> struct minmax_kernel {
+  static std::pair<T, T> scalar(const T *p, std::size_t n) noexcept {
+    T lo = p[0];
+    T hi = p[0];
+    for (std::size_t i = 1; i < n; ++i) {
+      lo = p[i] < lo ? p[i] : lo;
+      hi = hi < p[i] ? p[i] : hi;
+    }
+    return {lo, hi};
+  }
+
+  template <std::size_t W>
+  [[gnu::always_inline]] static std::pair<T, T> run(const T *p,
+                                                    std::size_t n) noexcept {
+    using L = lanes<T, W>;
+    using V = typename L::vec;
+    if (n < 2 * L::count) {
+      return scalar(p, n);
+    }
+    V lo = load<L>(p);
+    V hi = lo;
+    V lo2 = load<L>(p + L::count);
+    V hi2 = lo2;
+    std::size_t i = 2 * L::count;
+    for (; i + 2 * L::count <= n; i += 2 * L::count) {
+      V a = load<L>(p + i);
+      V b = load<L>(p + i + L::count);
+      lo = a < lo ? a : lo;
+      hi = hi < a ? a : hi;
+      lo2 = b < lo2 ? b : lo2;
+      hi2 = hi2 < b ? b : hi2;
+    }
+    lo = lo2 < lo ? lo2 : lo;
+    hi = hi < hi2 ? hi2 : hi;
+    std::pair<T, T> result = scalar(p + i - 1, n - i + 1);
+    for (std::size_t k = 0; k < L::count; ++k) {
+      result.first = lo[k] < result.first ? lo[k] : result.first;
+      result.second = result.second < hi[k] ? hi[k] : result.second;
+    }
+    return result;
+  }
+};
+
+template <typename T> struct mismatch_kernel {
+  static std::size_t scalar(const T *a, const T *b, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (!(a[i] == b[i])) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  template <std::size_t W>
+  [[gnu::always_inline]] static std::size_t run(const T *a, const T *b,
+                                                std::size_t n) noexcept {
+    using L = lanes<T, W>;
+    constexpr std::size_t step = 4 * L::count;
+    std::size_t i = 0;
+    for (; i + step <= n; i += step) {
+      if (any<L>(load<L>(a + i) != load<L>(b + i),
+                 load<L>(a + i + L::count) != load<L>(b + i + L::count),
+                 load<L>(a + i + 2 * L::count) != load<L>(b + i + 2 * L::count),
+                 load<L>(a + i + 3 * L::count) != load<L>(b + i + 3 * L::count))) {
+        break;
+      }
+    }
+    for (; i + L::count <= n; i += L::count) {
+      if (any<L>(load<L>(a + i) != load<L>(b + i))) {
+        break;
+      }
+    }
+    return i + scalar(a + i, b + i, n - i);
+  }
+};
+
+#ifdef S21_SIMD_X86
+// The kernels are inlined into these, so their vector code is compiled for
+// the named instruction set. Plain run<16> needs nothing beyond x86-64.
+template <typename Kernel, typename... Args>
+[[gnu::target("avx2")]] auto run_avx2(Args... args) noexcept {
+  return Kernel::template run<32>(args...);
+}
+
+template <typename Kernel, typename... Args>
+[[gnu::target("avx512f,avx512bw")]] auto run_avx512(Args... args) noexcept {
+  return Kernel::template run<64>(args...);
+}
+#endif
+
+template <typename Kernel, typename... Args>
+auto dispatch(Args... args) noexcept {
+  switch (active_level()) {
+#ifdef S21_SIMD_X86
+  case level::avx512:
+    return run_avx512<Kernel>(args...);
+  case level::avx2:
+    return run_avx2<Kernel>(args...);
+  case level::sse2:
+    return Kernel::template run<16>(args...);
+#endif
+  default:
+    return Kernel::scalar(args...);
+  }
+}
+}
+
+// Index of the first element equal to `value`, or `n`.
+template <vectorizable T>
+std::size_t find(const T *data, std::size_t n, T value) noexcept {
+  return detail::dispatch<detail::find_kernel<T>>(data, n, value);
+}
+
+// Number of elements equal to `value`.
+template <vectorizable T>
+std::size_t count(const T *data, std::size_t n, T value) noexcept {
+  return detail::dispatch<detail::count_kernel<T>>(data, n, value);
+}
+
+// Smallest and largest of `n` > 0 elements, compared with <. Unspecified
+// when the array holds a NaN.
+template <vectorizable T>
+std::pair<T, T> minmax(const T *data, std::size_t n) noexcept {
+  return detail::dispatch<detail::minmax_kernel<T>>(data, n);
+}
+
+// Index of the first position where the arrays differ (are not ==), or `n`.
+template <vectorizable T>
+std::size_t mismatch(const T *a, const T *b, std::size_t n) noexcept {
+  return detail::dispatch<detail::mismatch_kernel<T>>(a, b, n);
+}
+}
+
+}
+
+#endif
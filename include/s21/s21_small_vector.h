@@ -0,0 +1,30 @@
+#include "s21_vector.h"
+#include <memory>
+#include <memory_resource>
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+namespace s21 {
+// s21::vector with room for N elements inside the object itself. Nothing is
+// allocated while size() <= N; past that the elements move to a heap block
+// from `Allocator` and the capacity grows from N by `Growth`, as
+// s21::vector's does. shrink_to_fit() moves them back inline once they fit
+// again. Everything else, is_inline() aside, is s21::vector's interface.
+//
+// Moving a small_vector whose elements are inline moves the elements one by
+// one, so unlike s21::vector a move invalidates iterators and is O(N).
+template <typename T, size_t N, typename Allocator = std::allocator<T>,
+          typename Growth = growth::doubling>
+  requires(N > 0)
+using small_vector = vector<T, Allocator, Growth, N>;
+
+namespace pmr {
+template <typename T, size_t N, typename Growth = growth::doubling>
+using small_vector =
+    s21::small_vector<T, N, std::pmr::polymorphic_allocator<T>, Growth>;
+}
+
+}
+
+#endif
@@ -0,0 +1,317 @@
+#include "s21_vector.h"
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+namespace s21 {
+// A sequence of records stored as a structure of arrays: field I of every
+// row lives in its own s21::vector, column<I>(), so a pass over one field
+// streams through just that field's bytes and can run on the s21::simd
+// kernels (simd::count(column<1>().data(), size(), x) and so on).
+//
+// Rows are read and written through proxies: operator[] and the iterators
+// yield a std::tuple of references into the columns, which binds with
+// structured bindings and assigns field by field, and push_back() takes a
+// whole row as a std::tuple of values. All columns grow together, so they
+// keep one size and capacity; a row whose field throws while being added
+// is removed from the columns it already reached.
+template <typename... Fields> class soa_vector {
+  static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+public:
+  using value_type = std::tuple<Fields...>;
+  using reference = std::tuple<Fields &...>;
+  using const_reference = std::tuple<const Fields &...>;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <size_t I> using field_type = std::tuple_element_t<I, value_type>;
+
+  static constexpr size_type fields = sizeof...(Fields);
+
+private:
+  using indices = std::index_sequence_for<Fields...>;
+
+  template <bool Const> class basic_iterator;
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+private:
+  // Random access over row indices; dereferencing builds the row proxy.
+  template <bool Const> class basic_iterator {
+    using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+    owner *rows_ = nullptr;
+    size_type index_ = 0;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = soa_vector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, soa_vector::const_reference,
+                                         soa_vector::reference>;
+    using pointer = void;
+
+    basic_iterator() = default;
+    basic_iterator(owner *rows, size_type index) noexcept
+        : rows_(rows), index_(index) {}
+
+    operator basic_iterator<true>() const noexcept
+      requires(!Const)
+    {
+      return {rows_, index_};
+    }
+
+    size_type index() const noexcept { return index_; }
+
+    reference operator*() const noexcept { return (*rows_)[index_]; }
+    reference operator[](difference_type n) const noexcept {
+      return (*rows_)[index_ + n];
+    }
+
+    basic_iterator &operator++() noexcept {
+      ++index_;
+      return *this;
+    }
+    basic_iterator operator++(int) noexcept {
+      basic_iterator old = *this;
+      ++index_;
+      return old;
+    }
+    basic_iterator &operator--() noexcept {
+      --index_;
+      return *this;
+    }
+    basic_iterator operator--(int) noexcept {
+      basic_iterator old = *this;
+      --index_;
+      return old;
+    }
+    basic_iterator &operator+=(difference_type n) noexcept {
+      index_ += n;
+      return *this;
+    }
+    basic_iterator &operator-=(difference_type n) noexcept {
+      index_ -= n;
+      return *this;
+    }
+
+    friend basic_iterator operator+(basic_iterator it,
+                                    difference_type n) noexcept {
+      return it += n;
+    }
+    friend basic_iterator operator+(difference_type n,
+                                    basic_iterator it) noexcept {
+      return it += n;
+    }
+    friend basic_iterator operator-(basic_iterator it,
+                                    difference_type n) noexcept {
+      return it -= n;
+    }
+    friend difference_type operator-(const basic_iterator &a,
+                                      const basic_iterator &b) noexcept {
+      return static_cast<difference_type>(a.index_) -
+             static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const basic_iterator &a,
+                           const basic_iterator &b) noexcept {
+      return a.index_ == b.index_;
+    }
+    friend auto operator<=>(const basic_iterator &a,
+                            const basic_iterator &b) noexcept {
+      return a.index_ <=> b.index_;
+    }
+  };
+
+  std::tuple<vector<Fields>...> columns_;
+
+public:
+  soa_vector() = default;
+
+  soa_vector(std::initializer_list<value_type> rows) {
+    reserve(rows.size());
+    for (const value_type &row : rows) {
+      push_back(row);
+    }
+  }
+
+  // Field I of every row, contiguous.
+  template <size_t I> std::span<field_type<I>> column() noexcept {
+    auto &c = std::get<I>(columns_);
+    return {c.data(), c.size()};
+  }
+  template <size_t I> std::span<const field_type<I>> column() const noexcept {
+    const auto &c = std::get<I>(columns_);
+    return {c.data(), c.size()};
+  }
+
+  // Unchecked, like s21::vector's.
+  reference operator[](size_type index) noexcept {
+    S21_VECTOR_ASSERT(index < size());
+    return row<reference>(columns_, index, indices());
+  }
+  const_reference operator[](size_type index) const noexcept {
+    S21_VECTOR_ASSERT(index < size());
+    return row<const_reference>(columns_, index, indices());
+  }
+
+  reference at(size_type index) {
+    check_index(index);
+    return (*this)[index];
+  }
+  const_reference at(size_type index) const {
+    check_index(index);
+    return (*this)[index];
+  }
+
+  reference front() {
+    if (empty()) {
+      throw std::out_of_range(
+          "Front. The size is zero, you can't get anything.");
+    }
+    return (*this)[0];
+  }
+  const_reference front() const {
+    if (empty()) {
+      throw std::out_of_range(
+          "Front. The size is zero, you can't get anything.");
+    }
+    return (*this)[0];
+  }
+
+  reference back() {
+    if (empty()) {
+      throw std::out_of_range(
+          "Back. The size is zero, you can't get anything.");
+    }
+    return (*this)[size() - 1];
+  }
+  const_reference back() const {
+    if (empty()) {
+      throw std::out_of_range(
+          "Back. The size is zero, you can't get anything.");
+    }
+    return (*this)[size() - 1];
+  }
+
+  iterator begin() noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, size()}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator end() const noexcept { return {this, size()}; }
+
+  size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  size_type capacity() const noexcept {
+    return std::get<0>(columns_).capacity();
+  }
+  bool empty() const noexcept { return size() == 0; }
+
+  void reserve(size_type new_capacity) {
+    std::apply([&](auto &...c) { (c.reserve(new_capacity), ...); }, columns_);
+  }
+
+  void shrink_to_fit() {
+    std::apply([](auto &...c) { (c.shrink_to_fit(), ...); }, columns_);
+  }
+
+  void clear() {
+    std::apply([](auto &...c) { (c.clear(), ...); }, columns_);
+  }
+
+  // Appends a row built from one argument per field.
+  template <typename... Args>
+    requires(sizeof...(Args) == sizeof...(Fields) &&
+             (std::constructible_from<Fields, Args> && ...))
+  reference emplace_back(Args &&...args) {
+    if (size() == capacity()) {
+      // The arguments may refer to rows that growing is about to move.
+      value_type staged(std::forward<Args>(args)...);
+      reserve(growth::doubling::next(capacity(), 0));
+      append(std::move(staged), indices());
+    } else {
+      append(std::forward_as_tuple(std::forward<Args>(args)...), indices());
+    }
+    return (*this)[size() - 1];
+  }
+
+  // A row proxy converts to value_type, so push_back(other[i]) copies a
+  // row from another soa_vector, or from this one.
+  void push_back(const value_type &row) {
+    std::apply([&](const Fields &...f) { emplace_back(f...); }, row);
+  }
+  void push_back(value_type &&row) {
+    std::apply([&](Fields &...f) { emplace_back(std::move(f)...); }, row);
+  }
+
+  void pop_back() {
+    if (empty()) {
+      throw std::runtime_error(
+          "Pop back. The size is zero, you can't remove anything.");
+    }
+    std::apply([](auto &...c) { (c.pop_back(), ...); }, columns_);
+  }
+
+  // Removes the row at `pos` and returns an iterator to the row after it.
+  iterator erase(const_iterator pos) {
+    size_type index = pos.index();
+    if (index >= size()) {
+      throw std::runtime_error(
+          "Erase. Invalid position: position to erase, out of bounds.");
+    }
+    std::apply([&](auto &...c) { (c.erase(c.begin() + index), ...); },
+               columns_);
+    return {this, index};
+  }
+
+  void swap(soa_vector &other) noexcept { columns_.swap(other.columns_); }
+
+  friend bool operator==(const soa_vector &a, const soa_vector &b)
+    requires(std::equality_comparable<Fields> && ...)
+  {
+    return a.columns_ == b.columns_;
+  }
+
+private:
+  template <typename Row, typename Columns, size_t... I>
+  static Row row(Columns &columns, size_type index,
+                 std::index_sequence<I...>) noexcept {
+    return Row(std::get<I>(columns).data()[index]...);
+  }
+
+  // Capacity is already there, so only building a field can throw; the
+  // fields added before it are then popped again.
+  template <typename Values, size_t... I>
+  void append(Values &&values, std::index_sequence<I...>) {
+    size_type added = 0;
+    try {
+      ((std::get<I>(columns_).emplace_back(
+            std::get<I>(std::forward<Values>(values))),
+        ++added),
+       ...);
+    } catch (...) {
+      ((I < added ? std::get<I>(columns_).pop_back() : void()), ...);
+      throw;
+    }
+  }
+
+  void check_index(size_type index) const {
+    if (index >= size()) {
+      throw std::out_of_range(
+          "Operator \"at\": Invalid index. Index out of range.");
+    }
+  }
+};
+}
+
+#endif
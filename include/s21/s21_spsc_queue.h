@@ -0,0 +1,179 @@
+#include "s21_cache_line.h"
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+namespace s21 {
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. The producer owns tail_ and the consumer owns head_; each
+// publishes its index with a release store and reads the other's with an
+// acquire load, which is all the synchronization a slot handoff needs.
+//
+// Each side also keeps a private copy of the other side's index and reloads
+// the shared one only when the copy says the queue is full (or empty), so
+// in steady state neither thread touches the other's cache line.
+template <typename T> class spsc_queue {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+private:
+  alignas(cache_line_size) std::atomic<size_type> head_{0};
+  size_type cached_tail_ = 0;
+  alignas(cache_line_size) std::atomic<size_type> tail_{0};
+  size_type cached_head_ = 0;
+  alignas(cache_line_size) T *slots_ = nullptr;
+  size_type mask_ = 0;
+
+  static size_type round_up(size_type n) noexcept {
+    size_type capacity = 1;
+    while (capacity < n) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  // Number of free slots as seen by the producer, refreshing its view of
+  // head_ only when the cached one shows fewer than `wanted`.
+  size_type free_slots(size_type tail, size_type wanted) noexcept {
+    size_type free = capacity() - (tail - cached_head_);
+    if (free < wanted) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      free = capacity() - (tail - cached_head_);
+    }
+    return free;
+  }
+
+  // Number of filled slots as seen by the consumer.
+  size_type filled_slots(size_type head, size_type wanted) noexcept {
+    size_type filled = cached_tail_ - head;
+    if (filled < wanted) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+      filled = cached_tail_ - head;
+    }
+    return filled;
+  }
+
+public:
+  // Capacity is rounded up to a power of two.
+  explicit spsc_queue(size_type capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument(
+          "Spsc queue. Capacity must be greater than zero.");
+    }
+    size_type rounded = round_up(capacity);
+    slots_ = static_cast<T *>(::operator new(rounded * sizeof(T)));
+    mask_ = rounded - 1;
+  }
+
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+
+  // Both threads must be done with the queue.
+  ~spsc_queue() {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+      slots_[i & mask_].~T();
+    }
+    ::operator delete(slots_);
+  }
+
+  // Producer side. Returns false, leaving the arguments untouched, when the
+  // queue is full.
+  template <typename... Args> bool try_emplace(Args &&...args) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    if (free_slots(tail, 1) == 0) {
+      return false;
+    }
+    new (&slots_[tail & mask_]) T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+  // Producer side. Pushes as many elements of [first, last) as fit and
+  // publishes them with a single store; returns how many were pushed.
+  template <typename InputIt>
+  size_type try_push_batch(InputIt first, InputIt last) {
+    size_type tail = tail_.load(std::memory_order_relaxed);
+    size_type wanted = capacity();
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<
+                                        InputIt>::iterator_category>) {
+      wanted = static_cast<size_type>(std::distance(first, last));
+    }
+    size_type free = free_slots(tail, wanted);
+    size_type pushed = 0;
+    try {
+      for (; pushed < free && first != last; ++pushed, ++first) {
+        new (&slots_[(tail + pushed) & mask_]) T(*first);
+      }
+    } catch (...) {
+      tail_.store(tail + pushed, std::memory_order_release);
+      throw;
+    }
+    tail_.store(tail + pushed, std::memory_order_release);
+    return pushed;
+  }
+
+  // Consumer side. Moves the front element into `out`; returns false when
+  // the queue is empty.
+  bool try_pop(T &out) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    if (filled_slots(head, 1) == 0) {
+      return false;
+    }
+    T &slot = slots_[head & mask_];
+    out = std::move(slot);
+    slot.~T();
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Moves up to `max` elements to `out` and releases their
+  // slots with a single store; returns how many were popped.
+  template <typename OutputIt>
+  size_type try_pop_batch(OutputIt out, size_type max) {
+    size_type head = head_.load(std::memory_order_relaxed);
+    size_type filled = filled_slots(head, max);
+    size_type count = filled < max ? filled : max;
+    size_type popped = 0;
+    try {
+      for (; popped < count; ++popped, ++out) {
+        T &slot = slots_[(head + popped) & mask_];
+        *out = std::move(slot);
+        slot.~T();
+      }
+    } catch (...) {
+      head_.store(head + popped, std::memory_order_release);
+      throw;
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // Exact only while neither side is running. head_ is read first so the
+  // later tail_ can only be further ahead.
+  size_type size_approx() const noexcept {
+    size_type head = head_.load(std::memory_order_acquire);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  bool empty() const noexcept { return size_approx() == 0; }
+  size_type capacity() const noexcept { return mask_ + 1; }
+};
+
+}
+
+#endif
@@ -0,0 +1,692 @@
+#include "s21_vector.h"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifndef UNORDERED_MAP_H
+#define UNORDERED_MAP_H
+
+namespace s21 {
+// Hash map with open addressing in the SwissTable layout. Each slot has a
+// control byte: kEmpty, or the low 7 bits of the key's hash (H2) when full.
+// A lookup starts at the slot picked by the remaining bits (H1) and compares
+// 16 control bytes at once, touching a slot only when its H2 matches.
+//
+// Probing is linear and erase shifts the following run back into the hole,
+// so the table never holds tombstones and a probe stops at the first empty
+// byte. The control array repeats its first 15 bytes past the end so a
+// 16-byte load starting at any slot wraps around without a branch.
+//
+// Mirrors the s21::map member API. Insertions that grow the table and every
+// erase may move elements, so both invalidate iterators and references.
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+
+private:
+  using ctrl_t = signed char;
+  static constexpr ctrl_t kEmpty = -128;
+  static constexpr size_type group_width = 16;
+  static constexpr size_type min_capacity = 16;
+
+  using ctrl_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<ctrl_t>;
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<value_type>;
+  using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+  // Positions within a group whose control byte matched, lowest first.
+  struct bitmask {
+    std::uint32_t bits;
+
+    explicit operator bool() const noexcept { return bits != 0; }
+    size_type lowest() const noexcept { return std::countr_zero(bits); }
+    void clear_lowest() noexcept { bits &= bits - 1; }
+  };
+
+  // Sixteen consecutive control bytes. Full bytes are 0..127 and kEmpty is
+  // the only negative value, so the sign bits alone mark the empty slots.
+  struct group {
+#ifdef __SSE2__
+    __m128i ctrl;
+
+    explicit group(const ctrl_t *pos)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+    bitmask match(ctrl_t h2) const noexcept {
+      return {static_cast<std::uint32_t>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2))))};
+    }
+
+    bitmask match_empty() const noexcept {
+      return {static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl))};
+    }
+#else
+    const ctrl_t *ctrl;
+
+    explicit group(const ctrl_t *pos) : ctrl(pos) {}
+
+    bitmask match(ctrl_t h2) const noexcept {
+      std::uint32_t bits = 0;
+      for (size_type i = 0; i < group_width; ++i) {
+        bits |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+      }
+      return {bits};
+    }
+
+    bitmask match_empty() const noexcept {
+      std::uint32_t bits = 0;
+      for (size_type i = 0; i < group_width; ++i) {
+        bits |= static_cast<std::uint32_t>(ctrl[i] < 0) << i;
+      }
+      return {bits};
+    }
+#endif
+  };
+
+public:
+  class iterator {
+  public:
+    using value_type = std::pair<const Key, T>;
+    using reference = value_type &;
+    using pointer = value_type *;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    iterator() = default;
+
+    reference operator*() const { return *slot; }
+    pointer operator->() const { return slot; }
+
+    iterator &operator++() {
+      ++ctrl;
+      ++slot;
+      skip_empty();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    bool operator==(const iterator &other) const {
+      return ctrl == other.ctrl;
+    }
+    bool operator!=(const iterator &other) const { return !(*this == other); }
+
+  private:
+    friend class unordered_map;
+
+    iterator(const ctrl_t *c, value_type *s, const ctrl_t *e)
+        : ctrl(c), slot(s), end(e) {}
+
+    void skip_empty() noexcept {
+      while (ctrl != end && *ctrl == kEmpty) {
+        ++ctrl;
+        ++slot;
+      }
+    }
+
+    const ctrl_t *ctrl = nullptr;
+    value_type *slot = nullptr;
+    const ctrl_t *end = nullptr;
+  };
+
+private:
+  ctrl_t *ctrl_ = nullptr;
+  value_type *slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  [[no_unique_address]] hasher hash_;
+  [[no_unique_address]] key_equal eq_;
+  [[no_unique_address]] ctrl_allocator ctrl_alloc_;
+  [[no_unique_address]] slot_allocator slot_alloc_;
+
+public:
+  unordered_map() noexcept = default;
+
+  explicit unordered_map(size_type bucket_count) { reserve(bucket_count); }
+
+  template <typename InputIt> unordered_map(InputIt first, InputIt last) {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<
+                                        InputIt>::iterator_category>) {
+      reserve(static_cast<size_type>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  unordered_map(std::initializer_list<value_type> init)
+      : unordered_map(init.begin(), init.end()) {}
+
+  // Same capacity and hash function, so every element keeps its slot and the
+  // control bytes are copied as they are.
+  unordered_map(const unordered_map &other)
+      : hash_(other.hash_), eq_(other.eq_),
+        ctrl_alloc_(ctrl_traits::select_on_container_copy_construction(
+            other.ctrl_alloc_)),
+        slot_alloc_(slot_traits::select_on_container_copy_construction(
+            other.slot_alloc_)) {
+    if (other.size_ == 0)
+      return;
+    allocate_table(other.capacity_);
+    std::memcpy(ctrl_, other.ctrl_, ctrl_bytes(capacity_));
+    size_type i = 0;
+    try {
+      for (; i < capacity_; ++i) {
+        if (ctrl_[i] != kEmpty) {
+          slot_traits::construct(slot_alloc_, slots_ + i, other.slots_[i]);
+        }
+      }
+    } catch (...) {
+      destroy_slots(i);
+      free_table();
+      throw;
+    }
+    size_ = other.size_;
+  }
+
+  unordered_map(unordered_map &&other) noexcept
+      : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_),
+        size_(other.size_), hash_(std::move(other.hash_)),
+        eq_(std::move(other.eq_)), ctrl_alloc_(std::move(other.ctrl_alloc_)),
+        slot_alloc_(std::move(other.slot_alloc_)) {
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+  }
+
+  ~unordered_map() {
+    destroy_slots(capacity_);
+    free_table();
+  }
+
+  unordered_map &operator=(const unordered_map &other) {
+    if (this != &other) {
+      unordered_map copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  // Takes `other`'s table when the allocator propagates or the two compare
+  // equal; otherwise the table must stay with `other`'s allocator, so the
+  // elements are moved into a table from this map's.
+  unordered_map &operator=(unordered_map &&other) noexcept(
+      slot_traits::propagate_on_container_move_assignment::value ||
+      slot_traits::is_always_equal::value) {
+    if (this == &other) {
+      return *this;
+    }
+    clear();
+    free_table();
+    hash_ = std::move(other.hash_);
+    eq_ = std::move(other.eq_);
+    if constexpr (slot_traits::propagate_on_container_move_assignment::value) {
+      ctrl_alloc_ = std::move(other.ctrl_alloc_);
+      slot_alloc_ = std::move(other.slot_alloc_);
+    } else if (!(slot_alloc_ == other.slot_alloc_)) {
+      reserve(other.size_);
+      for (auto it = other.begin(); it != other.end(); ++it) {
+        try_emplace(it->first, std::move(it->second));
+      }
+      other.clear();
+      return *this;
+    }
+    ctrl_ = other.ctrl_;
+    slots_ = other.slots_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+    other.capacity_ = 0;
+    other.size_ = 0;
+    return *this;
+  }
+
+  unordered_map &operator=(std::initializer_list<value_type> ilist) {
+    clear();
+    reserve(ilist.size());
+    for (const auto &item : ilist) {
+      insert(item);
+    }
+    return *this;
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return try_emplace(value.first, std::move(value.second));
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    if constexpr (sizeof...(Args) == 2 && is_key_first<Args...>) {
+      return try_emplace(std::forward<Args>(args)...);
+    } else {
+      value_type value(std::forward<Args>(args)...);
+      return try_emplace(value.first, std::move(value.second));
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return emplace_unique(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return emplace_unique(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    auto result = emplace_unique(key, std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    auto result = emplace_unique(std::move(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  iterator find(const Key &key) {
+    size_type i = find_index(key);
+    return i == capacity_ ? end() : make_iterator(i);
+  }
+
+  bool contains(const Key &key) const { return find_index(key) != capacity_; }
+
+  T &operator[](const Key &key) { return at(key); }
+
+  T &at(const Key &key) {
+    size_type i = find_index(key);
+    if (i == capacity_) {
+      throw std::out_of_range("Key not found in map");
+    }
+    return slots_[i].second;
+  }
+
+  void erase(iterator pos) {
+    if (pos == end())
+      return;
+    erase_at(static_cast<size_type>(pos.ctrl - ctrl_));
+  }
+
+  size_type erase(const Key &key) {
+    size_type i = find_index(key);
+    if (i == capacity_)
+      return 0;
+    erase_at(i);
+    return 1;
+  }
+
+  // Moves every element whose key is absent here out of `other`.
+  void merge(unordered_map &other) {
+    if (this == &other)
+      return;
+    vector<Key> moved;
+    for (auto it = other.begin(); it != other.end(); ++it) {
+      if (try_emplace(it->first, std::move(it->second)).second) {
+        moved.push_back(it->first);
+      }
+    }
+    for (size_type i = 0; i < moved.size(); ++i) {
+      other.erase(moved[i]);
+    }
+  }
+
+  void swap(unordered_map &other) noexcept {
+    using std::swap;
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(hash_, other.hash_);
+    swap(eq_, other.eq_);
+    if constexpr (slot_traits::propagate_on_container_swap::value) {
+      swap(ctrl_alloc_, other.ctrl_alloc_);
+      swap(slot_alloc_, other.slot_alloc_);
+    }
+  }
+
+  // Destroys every element but keeps the table for reuse.
+  void clear() noexcept {
+    if (size_ == 0)
+      return;
+    destroy_slots(capacity_);
+    std::memset(ctrl_, kEmpty, ctrl_bytes(capacity_));
+    size_ = 0;
+  }
+
+  // Makes room for `count` elements without growing again.
+  void reserve(size_type count) {
+    size_type target = capacity_for(count);
+    if (target > capacity_) {
+      resize(target);
+    }
+  }
+
+  // Sets the slot count to at least `count` and enough for the current
+  // elements, shrinking if that is smaller than now. rehash(0) on an empty
+  // map frees the table.
+  void rehash(size_type count) {
+    if (count == 0 && size_ == 0) {
+      free_table();
+      return;
+    }
+    size_type target = std::bit_ceil(count < min_capacity ? min_capacity
+                                                          : count);
+    size_type needed = capacity_for(size_);
+    if (target < needed) {
+      target = needed;
+    }
+    if (target != capacity_) {
+      resize(target);
+    }
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  size_type bucket_count() const noexcept { return capacity_; }
+  float load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f
+                          : static_cast<float>(size_) /
+                                static_cast<float>(capacity_);
+  }
+  static constexpr float max_load_factor() noexcept { return 0.875f; }
+
+  iterator begin() {
+    iterator it(ctrl_, slots_, ctrl_ + capacity_);
+    it.skip_empty();
+    return it;
+  }
+  iterator end() { return iterator(ctrl_ + capacity_, nullptr, nullptr); }
+
+  void print() const {
+    std::cout << "Map contents (unordered):\n";
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] != kEmpty) {
+        std::cout << slots_[i].first << " = " << slots_[i].second << "\n";
+      }
+    }
+    std::cout << "\n";
+  }
+
+private:
+  template <typename First, typename...>
+  static constexpr bool is_key_first =
+      std::is_same_v<std::remove_cvref_t<First>, Key>;
+
+  static constexpr size_type ctrl_bytes(size_type capacity) noexcept {
+    return capacity + group_width - 1;
+  }
+
+  // Smallest power-of-two capacity holding `count` elements under the
+  // maximum load factor of 7/8.
+  static size_type capacity_for(size_type count) noexcept {
+    if (count == 0)
+      return 0;
+    size_type needed = count + (count + 6) / 7;
+    return std::bit_ceil(needed < min_capacity ? min_capacity : needed);
+  }
+
+  // Scrambles the user hash so H1 and H2 both see every input bit; integer
+  // std::hash is the identity.
+  size_type hash_of(const Key &key) const {
+    std::uint64_t h =
+        static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_type>(h ^ (h >> 32));
+  }
+
+  static ctrl_t h2(size_type hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+
+  static size_type h1(size_type hash, size_type mask) noexcept {
+    return (hash >> 7) & mask;
+  }
+
+  iterator make_iterator(size_type i) {
+    return iterator(ctrl_ + i, slots_ + i, ctrl_ + capacity_);
+  }
+
+  size_type find_index(const Key &key) const {
+    if (size_ == 0)
+      return capacity_;
+    size_type hash = hash_of(key);
+    size_type mask = capacity_ - 1;
+    size_type pos = h1(hash, mask);
+    while (true) {
+      group g(ctrl_ + pos);
+      for (bitmask m = g.match(h2(hash)); m; m.clear_lowest()) {
+        size_type i = (pos + m.lowest()) & mask;
+        if (eq_(slots_[i].first, key)) {
+          return i;
+        }
+      }
+      if (g.match_empty()) {
+        return capacity_;
+      }
+      pos = (pos + group_width) & mask;
+    }
+  }
+
+  // First empty slot on the probe sequence of `hash`; the table is never
+  // full, so one exists.
+  static size_type find_empty(const ctrl_t *ctrl, size_type mask,
+                              size_type hash) noexcept {
+    size_type pos = h1(hash, mask);
+    while (true) {
+      bitmask empty = group(ctrl + pos).match_empty();
+      if (empty) {
+        return (pos + empty.lowest()) & mask;
+      }
+      pos = (pos + group_width) & mask;
+    }
+  }
+
+  // Writes a control byte and its mirror past the end.
+  static void set_ctrl(ctrl_t *ctrl, size_type capacity, size_type i,
+                       ctrl_t value) noexcept {
+    ctrl[i] = value;
+    if (i < group_width - 1) {
+      ctrl[capacity + i] = value;
+    }
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(K &&key, Args &&...args) {
+    size_type i = find_index(key);
+    if (i != capacity_) {
+      return {make_iterator(i), false};
+    }
+    size_type hash = hash_of(key);
+    if (size_ + 1 > capacity_ - capacity_ / 8) {
+      // The arguments may refer to an element, so the new one is built in
+      // the grown table before the old elements move.
+      unordered_map fresh = empty_like(capacity_ == 0 ? min_capacity
+                                                      : capacity_ * 2);
+      i = fresh.construct_at(hash, std::forward<K>(key),
+                             std::forward<Args>(args)...);
+      transfer_into(fresh);
+      adopt(fresh);
+      return {make_iterator(i), true};
+    }
+    i = construct_at(hash, std::forward<K>(key), std::forward<Args>(args)...);
+    return {make_iterator(i), true};
+  }
+
+  // Builds an element for a key known to be absent; returns its slot.
+  template <typename K, typename... Args>
+  size_type construct_at(size_type hash, K &&key, Args &&...args) {
+    size_type i = find_empty(ctrl_, capacity_ - 1, hash);
+    slot_traits::construct(slot_alloc_, slots_ + i, std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    set_ctrl(ctrl_, capacity_, i, h2(hash));
+    ++size_;
+    return i;
+  }
+
+  // Removes slot `i`, then walks the run after it and pulls back every
+  // element whose probe sequence passes over the hole, so lookups can keep
+  // stopping at the first empty slot.
+  void erase_at(size_type i) {
+    size_type mask = capacity_ - 1;
+    slot_traits::destroy(slot_alloc_, slots_ + i);
+    size_type hole = i;
+    for (size_type j = (i + 1) & mask; ctrl_[j] != kEmpty; j = (j + 1) & mask) {
+      size_type home = h1(hash_of(slots_[j].first), mask);
+      if (((j - hole) & mask) <= ((j - home) & mask)) {
+        relocate(slots_ + hole, slots_ + j);
+        set_ctrl(ctrl_, capacity_, hole, ctrl_[j]);
+        hole = j;
+      }
+    }
+    set_ctrl(ctrl_, capacity_, hole, kEmpty);
+    --size_;
+  }
+
+  void relocate(value_type *dst, value_type *src) {
+    if constexpr (is_trivially_relocatable_v<value_type>) {
+      std::memcpy(static_cast<void *>(dst), static_cast<void *>(src),
+                  sizeof(value_type));
+    } else {
+      slot_traits::construct(slot_alloc_, dst, std::move(*src));
+      slot_traits::destroy(slot_alloc_, src);
+    }
+  }
+
+  void allocate_table(size_type capacity) {
+    ctrl_ = ctrl_traits::allocate(ctrl_alloc_, ctrl_bytes(capacity));
+    try {
+      slots_ = slot_traits::allocate(slot_alloc_, capacity);
+    } catch (...) {
+      ctrl_traits::deallocate(ctrl_alloc_, ctrl_, ctrl_bytes(capacity));
+      ctrl_ = nullptr;
+      throw;
+    }
+    std::memset(ctrl_, kEmpty, ctrl_bytes(capacity));
+    capacity_ = capacity;
+  }
+
+  // Destroys the elements in slots [0, limit).
+  void destroy_slots(size_type limit) noexcept {
+    if (size_ == 0 && limit == capacity_)
+      return;
+    for (size_type i = 0; i < limit; ++i) {
+      if (ctrl_[i] != kEmpty) {
+        slot_traits::destroy(slot_alloc_, slots_ + i);
+      }
+    }
+  }
+
+  void free_table() noexcept {
+    if (ctrl_) {
+      ctrl_traits::deallocate(ctrl_alloc_, ctrl_, ctrl_bytes(capacity_));
+      slot_traits::deallocate(slot_alloc_, slots_, capacity_);
+    }
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+  }
+
+  unordered_map(const hasher &hash, const key_equal &eq,
+                const ctrl_allocator &ctrl_alloc,
+                const slot_allocator &slot_alloc)
+      : hash_(hash), eq_(eq), ctrl_alloc_(ctrl_alloc), slot_alloc_(slot_alloc) {
+  }
+
+  // An empty table of `capacity` slots sharing this map's allocators. They
+  // are copied in at construction, since some allocators (such as
+  // polymorphic_allocator) cannot be assigned.
+  unordered_map empty_like(size_type capacity) const {
+    unordered_map fresh(hash_, eq_, ctrl_alloc_, slot_alloc_);
+    fresh.allocate_table(capacity);
+    return fresh;
+  }
+
+  // Copies or moves every element into `fresh`. Elements are moved only
+  // when that cannot throw, so on failure this map is left intact and
+  // `fresh` cleans up after itself.
+  void transfer_into(unordered_map &fresh) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] == kEmpty)
+        continue;
+      size_type hash = hash_of(slots_[i].first);
+      size_type j = find_empty(fresh.ctrl_, fresh.capacity_ - 1, hash);
+      slot_traits::construct(fresh.slot_alloc_, fresh.slots_ + j,
+                             std::move_if_noexcept(slots_[i]));
+      set_ctrl(fresh.ctrl_, fresh.capacity_, j, h2(hash));
+      ++fresh.size_;
+    }
+  }
+
+  // Drops the current table and takes over `fresh`'s.
+  void adopt(unordered_map &fresh) noexcept {
+    destroy_slots(capacity_);
+    free_table();
+    ctrl_ = fresh.ctrl_;
+    slots_ = fresh.slots_;
+    capacity_ = fresh.capacity_;
+    size_ = fresh.size_;
+    fresh.ctrl_ = nullptr;
+    fresh.slots_ = nullptr;
+    fresh.capacity_ = 0;
+    fresh.size_ = 0;
+  }
+
+  void resize(size_type new_capacity) {
+    unordered_map fresh = empty_like(new_capacity);
+    transfer_into(fresh);
+    adopt(fresh);
+  }
+};
+
+}
+
+#endif
@@ -1,12 +1,114 @@
+#include "s21_simd.h"
+#include "s21_vector_io.h"
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
 
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#ifdef S21_VECTOR_DEBUG
+#include <cassert>
+#define S21_VECTOR_ASSERT(cond) assert(cond)
+#else
+#define S21_VECTOR_ASSERT(cond) ((void)0)
+#endif
+
 namespace s21 {
-template <typename T> class vector {
+// A type is trivially relocatable when moving it to a new address and
+// dropping the original is equivalent to copying its bytes. That holds for
+// every trivially copyable type; other types (e.g. ones owning a heap pointer
+// without self-references) may opt in by specializing this trait.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// std::pair declares its own assignment operators, so it is never trivially
+// copyable, but it relocates bitwise whenever both members do.
+template <typename A, typename B>
+struct is_trivially_relocatable<std::pair<A, B>>
+    : std::bool_constant<is_trivially_relocatable_v<A> &&
+                         is_trivially_relocatable_v<B>> {};
+
+// Growth policies for s21::vector. `next(capacity, element_size)` returns
+// the capacity to grow to when one more element does not fit; it must be
+// larger than `capacity`. Bulk insertions grow to at least what they need.
+namespace growth {
+// Amortized O(1) appends with up to 2x unused capacity.
+struct doubling {
+  static constexpr size_t next(size_t capacity, size_t) noexcept {
+    return capacity == 0 ? 1 : capacity * 2;
+  }
+};
+
+// Bounds unused capacity to a half, at the cost of more reallocations.
+struct one_and_half {
+  static constexpr size_t next(size_t capacity, size_t) noexcept {
+    return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+  }
+};
+
+// Doubles while the buffer is smaller than a page, then grows by half with
+// the byte size rounded up to whole pages, which is what a large allocation
+// costs anyway. Elements of a page or more may round back down to the
+// current capacity, so at least one more element is always added.
+template <size_t PageSize = 4096> struct page_rounded {
+  static constexpr size_t next(size_t capacity, size_t element_size) noexcept {
+    if (capacity * element_size < PageSize) {
+      return doubling::next(capacity, element_size);
+    }
+    size_t bytes = (capacity + capacity / 2) * element_size;
+    size_t rounded = (bytes + PageSize - 1) / PageSize * PageSize / element_size;
+    return rounded > capacity ? rounded : capacity + 1;
+  }
+};
+}
+
+namespace detail {
+// Room for N elements inside the vector object itself; empty when N is 0.
+template <typename T, size_t N> struct inline_buffer {
+  alignas(T) unsigned char bytes[N * sizeof(T)];
+
+  T *data() const noexcept {
+    return reinterpret_cast<T *>(const_cast<unsigned char *>(bytes));
+  }
+};
+
+template <typename T> struct inline_buffer<T, 0> {
+  T *data() const noexcept { return nullptr; }
+};
+}
+
+// All storage comes from `Allocator` through std::allocator_traits, and
+// elements are built and destroyed with its construct and destroy, so a
+// polymorphic allocator hands its memory resource on to elements that use
+// allocators themselves. The allocator's pointer type must be a plain T*.
+// `Growth` is one of the s21::growth policies.
+//
+// With `InlineCapacity` above zero the first that many elements live in the
+// object itself, as in s21::small_vector, and nothing is allocated until
+// they no longer fit. Inline elements cannot change hands as a block, so
+// moving or swapping such a vector moves them one by one.
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Growth = growth::doubling, size_t InlineCapacity = 0>
+class vector {
 public:
   using value_type = T;
+  using allocator_type = Allocator;
+  using growth_policy = Growth;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
@@ -14,18 +116,41 @@ public:
   using const_pointer = const T *;
   using iterator = pointer;
 
+  static constexpr size_type inline_capacity = InlineCapacity;
+
 private:
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::pointer, pointer>,
+                "vector needs an allocator whose pointer type is T*");
+
+  // Swapping storage only trades pointers unless elements are inline.
+  static constexpr bool nothrow_storage_swap =
+      inline_capacity == 0 || (std::is_nothrow_move_constructible_v<T> &&
+                               std::is_nothrow_swappable_v<T>);
+
   size_type size_ = 0;
-  size_type capacity_ = 0;
-  pointer data_ = nullptr;
+  size_type capacity_ = inline_capacity;
+  pointer data_ = inline_.data();
+  [[no_unique_address]] Allocator alloc_;
+  [[no_unique_address]] detail::inline_buffer<T, InlineCapacity> inline_;
 
 public:
-  vector() noexcept = default;
-  vector(size_type size) {
+  vector() noexcept(noexcept(Allocator())) = default;
+  explicit vector(const Allocator &alloc) noexcept : alloc_(alloc) {}
+  vector(size_type size, const Allocator &alloc = Allocator()) : alloc_(alloc) {
     if (size > 0) {
-      allocate(size);
-      for (size_type i = 0; i < size_; ++i) {
-        new (&data_[i]) value_type();
+      if (size > capacity_) {
+        data_ = allocate_block(size);
+        capacity_ = size;
+      }
+      try {
+        for (; size_ < size; ++size_) {
+          alloc_traits::construct(alloc_, data_ + size_);
+        }
+      } catch (...) {
+        clear();
+        free_block(data_, capacity_);
+        throw;
       }
     } else if (size < 0) {
       throw std::runtime_error(
@@ -34,73 +159,424 @@ public:
   }
   ~vector() noexcept {
     clear();
+    free_block(data_, capacity_);
     capacity_ = 0;
-    ::operator delete(data_);
   }
 
-  vector(const vector<value_type> &other) {
+  vector(const vector &other)
+      : vector(other,
+               alloc_traits::select_on_container_copy_construction(
+                   other.alloc_)) {}
+
+  vector(const vector &other, const Allocator &alloc) : alloc_(alloc) {
     if (other.size_ > 0) {
-      allocate(other.size_);
-      for (size_type i = 0; i < size_; ++i) {
-        new (&data_[i]) value_type(other[i]);
-      }
+      append_copies(other.data_, other.size_);
     }
   }
 
-  vector(std::initializer_list<value_type> list) : size_(0), capacity_(0) {
-    data_ =
-        static_cast<pointer>(::operator new(list.size() * sizeof(value_type)));
-    for (const auto &item : list) {
-      new (&data_[size_++]) value_type(item);
+  vector(std::initializer_list<value_type> list,
+         const Allocator &alloc = Allocator())
+      : alloc_(alloc) {
+    if (list.size() > 0) {
+      append_copies(list.begin(), list.size());
     }
-    capacity_ = size_;
   }
 
-  vector(vector &&other) noexcept
-      : size_(other.size_), capacity_(other.size_), data_(other.data_) {
-    other.data_ = nullptr;
-    other.size_ = 0;
-    other.capacity_ = 0;
+  vector(vector &&other) noexcept(nothrow_storage_swap)
+      : alloc_(std::move(other.alloc_)) {
+    swap_storage(other);
+  }
+
+  // Takes over the block when `alloc` can free it; otherwise moves the
+  // elements one by one into storage from `alloc`.
+  vector(vector &&other, const Allocator &alloc) : alloc_(alloc) {
+    if (alloc_ == other.alloc_) {
+      swap_storage(other);
+    } else if (other.size_ > 0) {
+      reserve(other.size_);
+      for (size_type i = 0; i < other.size_; ++i) {
+        emplace_back(std::move(other.data_[i]));
+      }
+      other.clear();
+    }
   }
 
+  // Both assignments build the result with the allocator the target ends up
+  // with (the source's when the traits say it propagates) and then trade
+  // storage with it; the allocator is traded too only when it propagates.
   vector &operator=(const vector &other) {
-    if (this == &other) {
-      return *this;
+    using propagate = alloc_traits::propagate_on_container_copy_assignment;
+    if (this != &other) {
+      vector copy(other, propagate::value ? other.alloc_ : alloc_);
+      swap_storage(copy);
+      if constexpr (propagate::value) {
+        using std::swap;
+        swap(alloc_, copy.alloc_);
+      }
     }
-    clear();
-    capacity_ = 0;
-    ::operator delete(data_);
-    allocate(other.size_);
-    for (size_type i = 0; i < size_; ++i) {
-      new (&data_[i]) value_type(other[i]);
+    return *this;
+  }
+
+  vector &operator=(vector &&other) noexcept(
+      nothrow_storage_swap &&
+      (alloc_traits::propagate_on_container_move_assignment::value ||
+       alloc_traits::is_always_equal::value)) {
+    using propagate = alloc_traits::propagate_on_container_move_assignment;
+    if (this != &other) {
+      vector moved(std::move(other), propagate::value ? other.alloc_ : alloc_);
+      swap_storage(moved);
+      if constexpr (propagate::value) {
+        using std::swap;
+        swap(alloc_, moved.alloc_);
+      }
     }
     return *this;
   }
 
-  vector &operator=(vector &&other) {
+  allocator_type get_allocator() const noexcept { return alloc_; }
+
+  // True while the elements live in the object's own storage; never for a
+  // vector without inline capacity.
+  bool is_inline() const noexcept {
+    if constexpr (inline_capacity == 0) {
+      return false;
+    } else {
+      return data_ == inline_.data();
+    }
+  }
+
+private:
+  void check_index(size_type index) const {
+    if (index >= size_) {
+      throw std::out_of_range(
+          "Operator \"at\": Invalid index. Index out of range.");
+    }
+  }
+
+  size_type grown_capacity() const noexcept {
+    return Growth::next(capacity_, sizeof(value_type));
+  }
+
+  // Capacity for holding `required` elements: what the policy would grow
+  // to, or exactly `required` when that is more.
+  size_type capacity_for(size_type required) const noexcept {
+    size_type grown = grown_capacity();
+    return grown > required ? grown : required;
+  }
+
+  // Yields the same element forever, so the fill overloads can share the
+  // range code paths.
+  struct repeat_iterator {
+    const_pointer value;
+
+    const_reference operator*() const noexcept { return *value; }
+    repeat_iterator &operator++() noexcept { return *this; }
+  };
+
+  bool holds(const_pointer p) const noexcept {
+    return std::less_equal<const_pointer>()(data_, p) &&
+           std::less<const_pointer>()(p, data_ + size_);
+  }
+
+  // Builds `n` elements from `first` in uninitialized memory at `dst`;
+  // if one throws, the ones already built are destroyed again.
+  template <typename It>
+  void construct_n(pointer dst, It first, size_type n) {
+    size_type built = 0;
+    try {
+      for (; built < n; ++built, ++first) {
+        alloc_traits::construct(alloc_, dst + built, *first);
+      }
+    } catch (...) {
+      for (size_type i = 0; i < built; ++i) {
+        alloc_traits::destroy(alloc_, dst + i);
+      }
+      throw;
+    }
+  }
+
+  // Opens a gap of `n` slots at `index`, reallocating at most once, and
+  // fills it with construct_n(gap, first, n). If that throws, the vector is
+  // left as it was.
+  template <typename It>
+  iterator insert_n(size_type index, It first, size_type n) {
+    if (index > size_) {
+      throw std::out_of_range(
+          "Insert. Invalid position: position to insert, out of range.");
+    }
+    if (n == 0) {
+      return begin() + index;
+    }
+    if (size_ + n > capacity_) {
+      if constexpr (reallocates_in_place) {
+        reallocate_to(capacity_for(size_ + n));
+      } else {
+        size_type new_capacity = capacity_for(size_ + n);
+        pointer new_data = allocate_block(new_capacity);
+        try {
+          construct_n(new_data + index, first, n);
+        } catch (...) {
+          free_block(new_data, new_capacity);
+          throw;
+        }
+        move_to_block(new_data, new_capacity, index, n);
+        size_ += n;
+        return begin() + index;
+      }
+    }
+    if (index == size_) {
+      construct_n(data_ + size_, first, n);
+    } else if constexpr (relocate_bitwise) {
+      size_type tail = (size_ - index) * sizeof(value_type);
+      std::memmove(static_cast<void *>(data_ + index + n),
+                   static_cast<void *>(data_ + index), tail);
+      try {
+        construct_n(data_ + index, first, n);
+      } catch (...) {
+        std::memmove(static_cast<void *>(data_ + index),
+                     static_cast<void *>(data_ + index + n), tail);
+        throw;
+      }
+    } else {
+      // Build past the end, then rotate the new elements into place.
+      construct_n(data_ + size_, first, n);
+      size_ += n;
+      std::rotate(data_ + index, data_ + size_ - n, data_ + size_);
+      return begin() + index;
+    }
+    size_ += n;
+    return begin() + index;
+  }
+
+  static constexpr bool relocate_bitwise = is_trivially_relocatable_v<T>;
+
+  // Allocators with a realloc-style `reallocate(p, old_n, new_n)`, such as
+  // s21::mmap_allocator, resize the block themselves and may do it without
+  // copying bytes. Only used when the elements may be moved bitwise and
+  // never live inline.
+  static constexpr bool reallocates_in_place =
+      relocate_bitwise && inline_capacity == 0 &&
+      requires(Allocator &a, pointer p, size_type n) {
+        { a.reallocate(p, n, n) } -> std::same_as<pointer>;
+      };
+
+  void reallocate_to(size_type new_capacity) {
+    if constexpr (reallocates_in_place) {
+      data_ = data_ ? alloc_.reallocate(data_, capacity_, new_capacity)
+                    : allocate_block(new_capacity);
+      capacity_ = new_capacity;
+    }
+  }
+
+  // reallocate_to() for the paths that build the new element in `staging`
+  // first: the staged element is destroyed if growing throws.
+  void reallocate_around(void *staging, size_type new_capacity) {
+    try {
+      reallocate_to(new_capacity);
+    } catch (...) {
+      std::destroy_at(std::launder(static_cast<pointer>(staging)));
+      throw;
+    }
+  }
+
+  pointer allocate_block(size_type n) {
+    return n == 0 ? nullptr : alloc_traits::allocate(alloc_, n);
+  }
+
+  // The inline buffer is never freed.
+  void free_block(pointer block, size_type n) noexcept {
+    if (block && block != inline_.data()) {
+      alloc_traits::deallocate(alloc_, block, n);
+    }
+  }
+
+  void reset_storage() noexcept {
+    data_ = inline_.data();
+    capacity_ = inline_capacity;
+  }
+
+  void destroy_n(pointer first, size_type n) noexcept {
+    for (size_type i = 0; i < n; ++i) {
+      alloc_traits::destroy(alloc_, first + i);
+    }
+  }
+
+  // Copies `n` elements from `src` into an empty vector, freeing everything
+  // again if one of the copies throws.
+  void append_copies(const_pointer src, size_type n) {
+    if (n > capacity_) {
+      data_ = allocate_block(n);
+      capacity_ = n;
+    }
+    try {
+      for (; size_ < n; ++size_) {
+        alloc_traits::construct(alloc_, data_ + size_, src[size_]);
+      }
+    } catch (...) {
+      clear();
+      free_block(data_, capacity_);
+      reset_storage();
+      throw;
+    }
+  }
+
+  template <typename It> void assign_n(It first, size_type n) {
+    clear();
+    if (n > capacity_) {
+      replace_storage(allocate_block(n), n);
+    }
+    construct_n(data_, first, n);
+    size_ = n;
+  }
+
+  // Builds `n` elements at uninitialized, non-overlapping `dst` from the
+  // ones at `src`, moving them when that cannot throw and copying them
+  // otherwise, like std::move_if_noexcept. The sources are left alive; if
+  // one throws, the elements already built are destroyed again.
+  void move_construct_n(pointer dst, pointer src, size_type n) {
+    if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>) {
+      construct_n(dst, std::make_move_iterator(src), n);
+    } else {
+      construct_n(dst, const_pointer(src), n);
+    }
+  }
+
+  // Moves `n` elements from `src` into uninitialized, non-overlapping `dst`
+  // and ends their lifetime at `src`. If a move throws, `src` still holds
+  // every element and `dst` none.
+  void relocate(pointer dst, pointer src, size_type n) {
+    if constexpr (relocate_bitwise) {
+      if (n > 0) {
+        std::memcpy(static_cast<void *>(dst), static_cast<void *>(src),
+                    n * sizeof(value_type));
+      }
+    } else {
+      move_construct_n(dst, src, n);
+      destroy_n(src, n);
+    }
+  }
+
+  // Frees the old block and adopts `new_data`, which must already hold the
+  // relocated elements.
+  void replace_storage(pointer new_data, size_type new_capacity) noexcept {
+    free_block(data_, capacity_);
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  // Relocates the elements into `new_data`, a block of `new_capacity` from
+  // allocate_block() or the inline buffer, leaving a gap of `gap` slots at
+  // `index` that the caller has already filled, and adopts it. Every element
+  // is built in the new block before any old one is destroyed, so if one
+  // throws, the gap's elements are destroyed, the block is freed and the
+  // vector is left as it was.
+  void move_to_block(pointer new_data, size_type new_capacity, size_type index,
+                     size_type gap) {
+    if constexpr (relocate_bitwise) {
+      relocate(new_data, data_, index);
+      relocate(new_data + index + gap, data_ + index, size_ - index);
+    } else {
+      try {
+        move_construct_n(new_data, data_, index);
+        try {
+          move_construct_n(new_data + index + gap, data_ + index,
+                           size_ - index);
+        } catch (...) {
+          destroy_n(new_data, index);
+          throw;
+        }
+      } catch (...) {
+        destroy_n(new_data + index, gap);
+        free_block(new_data, new_capacity);
+        throw;
+      }
+      destroy_n(data_, size_);
+    }
+    replace_storage(new_data, new_capacity);
+  }
+
+  // Trades elements with `other`, keeping each block with the allocator that
+  // the caller pairs it with. Heap blocks change hands as pointers; inline
+  // elements are moved across.
+  void swap_storage(vector &other) noexcept(nothrow_storage_swap) {
+    if constexpr (inline_capacity > 0) {
+      if (is_inline() || other.is_inline()) {
+        swap_inline(other);
+        return;
+      }
+    }
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(data_, other.data_);
+  }
+
+  // swap_storage() when at least one side is inline: a heap block moves as
+  // a pointer and the inline elements are relocated into the other's buffer.
+  void swap_inline(vector &other) {
     if (this == &other) {
-      return *this;
+      return;
     }
+    if (!is_inline()) {
+      other.swap_inline(*this);
+      return;
+    }
+    if (!other.is_inline()) {
+      relocate(other.inline_.data(), data_, size_);
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.reset_storage();
+    } else {
+      vector &longer = size_ < other.size_ ? other : *this;
+      vector &shorter = size_ < other.size_ ? *this : other;
+      std::swap_ranges(shorter.data_, shorter.data_ + shorter.size_,
+                       longer.data_);
+      relocate(shorter.data_ + shorter.size_, longer.data_ + shorter.size_,
+               longer.size_ - shorter.size_);
+    }
+    std::swap(size_, other.size_);
+  }
+
+  template <typename Source> void read_with(Source &source) {
     clear();
-    data_ = other.data_;
-    size_ = other.size_;
-    capacity_ = other.size_;
-    other.size_ = 0;
-    other.capacity_ = 0;
-    other.data_ = nullptr;
-    return *this;
+    vector_reader<vector> reader(source, std::move(*this));
+    *this = std::move(reader).take();
+  }
+
+  // Slow path of emplace_back: the new element is built in the new block
+  // first, since the arguments may refer to an element of this vector.
+  template <typename... Args>
+  reference grow_and_emplace_back(Args &&...args) {
+    if constexpr (reallocates_in_place) {
+      // Here the old block may move, so the element is built aside.
+      alignas(value_type) unsigned char staging[sizeof(value_type)];
+      new (staging) value_type(std::forward<Args>(args)...);
+      reallocate_around(staging, grown_capacity());
+      std::memcpy(static_cast<void *>(data_ + size_), staging,
+                  sizeof(value_type));
+      return data_[size_++];
+    }
+    size_type new_capacity = grown_capacity();
+    pointer new_data = allocate_block(new_capacity);
+    try {
+      alloc_traits::construct(alloc_, new_data + size_,
+                              std::forward<Args>(args)...);
+    } catch (...) {
+      free_block(new_data, new_capacity);
+      throw;
+    }
+    move_to_block(new_data, new_capacity, size_, 1);
+    return data_[size_++];
   }
 
+public:
   void allocate(int count) {
     size_ = count;
     capacity_ = count;
-    data_ =
-        static_cast<pointer>(::operator new(capacity_ * sizeof(value_type)));
+    data_ = allocate_block(capacity_);
   }
   void clear() {
-    for (size_type i = 0; i < size_; ++i) {
-      data_[i].~value_type();
-    }
+    destroy_n(data_, size_);
     size_ = 0;
   }
 
@@ -108,108 +584,284 @@ public:
     if (new_capacity <= capacity_) {
       return;
     }
-    pointer new_data =
-        static_cast<pointer>(::operator new(new_capacity * sizeof(value_type)));
-    for (size_type i = 0; i < size_; ++i) {
-      new (&new_data[i]) value_type(std::move_if_noexcept(data_[i]));
-      data_[i].~value_type();
+    if constexpr (reallocates_in_place) {
+      reallocate_to(new_capacity);
+      return;
     }
-    ::operator delete(data_);
-    data_ = new_data;
-    capacity_ = new_capacity;
+    move_to_block(allocate_block(new_capacity), new_capacity, size_, 0);
   }
 
+  // Inline elements stay where they are; elements that fit inline again
+  // move back there, and others into a block of exactly size() elements.
   void shrink_to_fit() {
-    if (size_ == capacity_) {
+    if (size_ == capacity_ || is_inline()) {
       return;
     }
-    pointer new_data =
-        static_cast<pointer>(::operator new(size_ * sizeof(value_type)));
-    for (size_type i = 0; i < size_; ++i) {
-      new (&new_data[i]) value_type(data_[i]);
-      data_[i].~value_type();
+    if constexpr (reallocates_in_place) {
+      if (size_ > 0) {
+        reallocate_to(size_);
+        return;
+      }
+    }
+    if (size_ <= inline_capacity) {
+      move_to_block(inline_.data(), inline_capacity, size_, 0);
+    } else {
+      move_to_block(allocate_block(size_), size_, size_, 0);
     }
-    ::operator delete(data_);
-    data_ = new_data;
-    capacity_ = size_;
   }
 
-  reference operator[](size_type index) const {
-    if (index >= size_) {
-      throw std::out_of_range(
-          "Operator []: Invalid index. Index out of range.");
-    }
+  // Unchecked, like std::vector. Define S21_VECTOR_DEBUG to assert on
+  // out-of-range indices; use at() for a checked access that throws.
+  reference operator[](size_type index) noexcept {
+    S21_VECTOR_ASSERT(index < size_);
+    return data_[index];
+  }
+  const_reference operator[](size_type index) const noexcept {
+    S21_VECTOR_ASSERT(index < size_);
     return data_[index];
   }
 
-  reference at(size_type index) const {
-    if (index >= size_) {
-      throw std::out_of_range(
-          "Operator \"at\": Invalid index. Index out of range.");
-    }
+  reference at(size_type index) {
+    check_index(index);
+    return data_[index];
+  }
+  const_reference at(size_type index) const {
+    check_index(index);
     return data_[index];
   }
 
   iterator insert(iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  // Inserts `count` copies of `value`, which may be an element of this
+  // vector.
+  iterator insert(iterator pos, size_type count, const_reference value) {
+    size_type index = pos - begin();
+    if (holds(&value)) {
+      value_type copy(value);
+      return insert_n(index, repeat_iterator{&copy}, count);
+    }
+    return insert_n(index, repeat_iterator{&value}, count);
+  }
+
+  // [first, last) must not point into this vector. Forward ranges are
+  // inserted with at most one reallocation; single-pass input is appended
+  // element by element and rotated into place.
+  template <std::input_iterator It>
+  iterator insert(iterator pos, It first, It last) {
+    size_type index = pos - begin();
+    if constexpr (std::forward_iterator<It>) {
+      return insert_n(index, first,
+                      static_cast<size_type>(std::distance(first, last)));
+    } else {
+      if (index > size_) {
+        throw std::out_of_range(
+            "Insert. Invalid position: position to insert, out of range.");
+      }
+      size_type old_size = size_;
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+      std::rotate(data_ + index, data_ + old_size, data_ + size_);
+      return begin() + index;
+    }
+  }
+
+  iterator insert(iterator pos, std::initializer_list<value_type> list) {
+    return insert_n(pos - begin(), list.begin(), list.size());
+  }
+
+  // Appends every element of `range`, reserving once when its size is
+  // known up front.
+  template <std::ranges::input_range R> void append_range(R &&range) {
+    if constexpr (std::ranges::forward_range<R> ||
+                  std::ranges::sized_range<R>) {
+      insert_n(size_, std::ranges::begin(range),
+               static_cast<size_type>(std::ranges::distance(range)));
+    } else {
+      for (auto &&item : range) {
+        emplace_back(std::forward<decltype(item)>(item));
+      }
+    }
+  }
+
+  // Replaces the contents. Storage is reused when it is large enough and
+  // otherwise replaced by a block of exactly the new size.
+  void assign(size_type count, const_reference value) {
+    if (holds(&value)) {
+      value_type copy(value);
+      assign_n(repeat_iterator{&copy}, count);
+    } else {
+      assign_n(repeat_iterator{&value}, count);
+    }
+  }
+
+  template <std::input_iterator It> void assign(It first, It last) {
+    if constexpr (std::forward_iterator<It>) {
+      assign_n(first, static_cast<size_type>(std::distance(first, last)));
+    } else {
+      clear();
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+  }
+
+  void assign(std::initializer_list<value_type> list) {
+    assign_n(list.begin(), list.size());
+  }
+
+  // Like std::string::resize_and_overwrite: makes room for `count`
+  // elements, lets `op(data(), count)` write them and keeps as many as op
+  // returns. Slots past the old size hold no value until op writes them,
+  // which is why T must be trivially copyable; capacity grows to exactly
+  // `count` if it has to.
+  template <typename Op>
+    requires std::is_trivially_copyable_v<T>
+  void resize_and_overwrite(size_type count, Op op) {
+    reserve(count);
+    size_type kept = std::move(op)(data_, count);
+    S21_VECTOR_ASSERT(kept <= count);
+    size_ = kept;
+  }
+
+  // Binary dump in the format of s21_vector_io.h: the checksummed header
+  // and data() in one writev on a descriptor, or two writes on a stream.
+  void write_to(int fd) const
+    requires std::is_trivially_copyable_v<T>
+  {
+    vector_io::write_all(fd, vector_io::make_header<T>(size_), data_,
+                         size_ * sizeof(T));
+  }
+
+  void write_to(std::ostream &out) const
+    requires std::is_trivially_copyable_v<T>
+  {
+    vector_io::write_all(out, vector_io::make_header<T>(size_), data_,
+                         size_ * sizeof(T));
+  }
+
+  // Replaces the contents with a dump written by write_to(), read straight
+  // into this vector's storage (reused when large enough) by a
+  // vector_reader. Throws on a foreign, corrupt or truncated dump, after
+  // which the vector is empty.
+  void read_from(int fd)
+    requires std::is_trivially_copyable_v<T>
+  {
+    read_with(fd);
+  }
+
+  void read_from(std::istream &in)
+    requires std::is_trivially_copyable_v<T>
+  {
+    read_with(in);
+  }
+
+  template <typename... Args>
+  iterator emplace(iterator pos, Args &&...args) {
     size_type new_pos = pos - begin();
     if (new_pos > size_) {
       throw std::out_of_range(
           "Insert. Invalid position: position to insert, out of range.");
     }
-    if (size_ == capacity_) {
-      size_type new_size = size_ + 1;
-      size_type new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
-      pointer new_data = static_cast<pointer>(
-          ::operator new(new_capacity * sizeof(value_type)));
-
-      for (size_type i = 0; i < new_pos; ++i) {
-        new (&new_data[i]) value_type(std::move_if_noexcept(data_[i]));
+    if (new_pos == size_) {
+      emplace_back(std::forward<Args>(args)...);
+      return begin() + new_pos;
+    }
+    if (!reallocates_in_place && size_ == capacity_) {
+      size_type new_capacity = grown_capacity();
+      pointer new_data = allocate_block(new_capacity);
+      try {
+        alloc_traits::construct(alloc_, new_data + new_pos,
+                                std::forward<Args>(args)...);
+      } catch (...) {
+        free_block(new_data, new_capacity);
+        throw;
       }
-      new (&new_data[new_pos]) T(std::move_if_noexcept(value));
-      for (size_type i = new_pos + 1; i < new_size; ++i) {
-        new (&new_data[i]) value_type(std::move_if_noexcept(data_[i - 1]));
+      move_to_block(new_data, new_capacity, new_pos, 1);
+      ++size_;
+    } else if constexpr (relocate_bitwise) {
+      // Build the element aside, slide the tail up one slot, then drop the
+      // element's bytes into the gap; no destructor runs on the staging copy.
+      alignas(value_type) unsigned char staging[sizeof(value_type)];
+      new (staging) value_type(std::forward<Args>(args)...);
+      if (size_ == capacity_) {
+        reallocate_around(staging, grown_capacity());
       }
-      clear();
-      ::operator delete(data_);
-      data_ = new_data;
-      size_ = new_size;
-      /*std::cout << "SIZE 1: " << size_ << " VALUE: " << value << std::endl;*/
-      capacity_ = new_capacity;
-    } else if (size_ < capacity_) {
-      new (&data_[size_]) T(std::move_if_noexcept(data_[size_ - 1]));
+      std::memmove(static_cast<void *>(data_ + new_pos + 1),
+                   static_cast<void *>(data_ + new_pos),
+                   (size_ - new_pos) * sizeof(value_type));
+      std::memcpy(static_cast<void *>(data_ + new_pos), staging,
+                  sizeof(value_type));
+      ++size_;
+    } else {
+      // Arguments may refer to an element that is about to be shifted.
+      value_type tmp(std::forward<Args>(args)...);
+      alloc_traits::construct(alloc_, data_ + size_,
+                              std::move(data_[size_ - 1]));
       for (size_type i = size_ - 1; i > new_pos; --i) {
-        data_[i] = data_[i - 1];
+        data_[i] = std::move(data_[i - 1]);
       }
-      data_[new_pos] = std::move_if_noexcept(value);
+      data_[new_pos] = std::move(tmp);
       ++size_;
-      /*std::cout << "SIZE 2: " << size_ << " VALUE: " << value << std::endl;*/
     }
     return begin() + new_pos;
   }
 
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (size_ == capacity_) {
+      return grow_and_emplace_back(std::forward<Args>(args)...);
+    }
+    alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+    return data_[size_++];
+  }
+
   void erase(iterator pos) {
     if (size_ == 0) {
       throw std::runtime_error(
           "Erase. The size is zero, you can't remove anything.");
     }
     size_type remove_pos = pos - begin();
-    if (remove_pos > size_) {
+    if (remove_pos >= size_) {
       throw std::runtime_error(
           "Erase. Invalid position: position to erase, out of bounds.");
     }
-    data_[remove_pos].~value_type();
-    for (size_type i = remove_pos; i < size_ - 1; ++i) {
-      data_[i] = data_[i + 1];
+    if constexpr (relocate_bitwise) {
+      alloc_traits::destroy(alloc_, data_ + remove_pos);
+      std::memmove(static_cast<void *>(data_ + remove_pos),
+                   static_cast<void *>(data_ + remove_pos + 1),
+                   (size_ - remove_pos - 1) * sizeof(value_type));
+    } else {
+      for (size_type i = remove_pos; i < size_ - 1; ++i) {
+        data_[i] = std::move(data_[i + 1]);
+      }
+      alloc_traits::destroy(alloc_, data_ + size_ - 1);
     }
     --size_;
   }
 
-  void push_back(const_reference value) { insert(end(), value); }
-  void pop_back() { erase(end()); }
-  void swap(vector &other) noexcept {
-    std::swap(size_, other.size_);
-    std::swap(capacity_, other.capacity_);
-    std::swap(data_, other.data_);
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+  void pop_back() {
+    if (size_ == 0) {
+      throw std::runtime_error(
+          "Pop back. The size is zero, you can't remove anything.");
+    }
+    alloc_traits::destroy(alloc_, data_ + --size_);
+  }
+  // Allocators are exchanged only when the traits say they propagate on
+  // swap; otherwise they must compare equal.
+  void swap(vector &other) noexcept(nothrow_storage_swap) {
+    swap_storage(other);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
   }
 
   pointer data() const noexcept { return data_; }
@@ -233,8 +885,79 @@ public:
   iterator begin() const { return data_; }
   iterator end() const { return data_ + size_; }
   bool empty() const { return begin() == end(); }
+
+  // Linear searches. For arithmetic T they run on the SIMD kernels of
+  // s21_simd.h, and on std::find and friends otherwise.
+  iterator find(const_reference value) const {
+    if constexpr (simd::vectorizable<T>) {
+      return data_ + simd::find(data_, size_, value);
+    } else {
+      return std::find(begin(), end(), value);
+    }
+  }
+
+  size_type count(const_reference value) const {
+    if constexpr (simd::vectorizable<T>) {
+      return simd::count(data_, size_, value);
+    } else {
+      return static_cast<size_type>(std::count(begin(), end(), value));
+    }
+  }
+
+  bool contains(const_reference value) const { return find(value) != end(); }
+
+  // The smallest and the largest element.
+  std::pair<value_type, value_type> minmax() const {
+    if (size_ == 0) {
+      throw std::out_of_range(
+          "Minmax. The size is zero, there is nothing to compare.");
+    }
+    if constexpr (simd::vectorizable<T>) {
+      return simd::minmax(data_, size_);
+    } else {
+      auto [lo, hi] = std::minmax_element(begin(), end());
+      return {*lo, *hi};
+    }
+  }
+
+  friend bool operator==(const vector &a, const vector &b)
+    requires std::equality_comparable<T>
+  {
+    if (a.size_ != b.size_) {
+      return false;
+    }
+    if constexpr (simd::vectorizable<T>) {
+      return simd::mismatch(a.data_, b.data_, a.size_) == a.size_;
+    } else {
+      return std::equal(a.begin(), a.end(), b.begin());
+    }
+  }
+
+  // Lexicographic, like std::vector's: the first unequal pair decides, and
+  // otherwise the shorter vector orders first.
+  friend auto operator<=>(const vector &a, const vector &b)
+    requires std::three_way_comparable<T>
+  {
+    if constexpr (simd::vectorizable<T>) {
+      using ordering = std::compare_three_way_result_t<T>;
+      size_type n = a.size_ < b.size_ ? a.size_ : b.size_;
+      size_type i = simd::mismatch(a.data_, b.data_, n);
+      if (i < n) {
+        return ordering(a.data_[i] <=> b.data_[i]);
+      }
+      return ordering(a.size_ <=> b.size_);
+    } else {
+      return std::lexicographical_compare_three_way(a.begin(), a.end(),
+                                                    b.begin(), b.end());
+    }
+  }
 };
 
+namespace pmr {
+template <typename T, typename Growth = growth::doubling>
+using vector = s21::vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+}
+
 }
 
 #endif
@@ -0,0 +1,267 @@
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <sys/uio.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+#ifndef VECTOR_IO_H
+#define VECTOR_IO_H
+
+namespace s21 {
+// Binary format of s21::vector::write_to(): a 32-byte header followed by
+// the elements' bytes exactly as they sit in data(). The header carries the
+// element count, element size and alignment and a format version, and is
+// protected by a checksum of its other fields, so a truncated, foreign or
+// corrupted file is refused before anything is allocated. The elements
+// themselves are not checksummed; reading them back costs no more than
+// copying them off the file.
+//
+// Only trivially copyable element types can be written, and files are only
+// readable on a machine with the same byte order and type layout.
+namespace vector_io {
+inline constexpr std::uint32_t magic = 0x56313253; // "S21V"
+inline constexpr std::uint16_t version = 1;
+
+struct header {
+  std::uint32_t magic;
+  std::uint16_t version;
+  std::uint16_t header_size;
+  std::uint32_t element_size;
+  std::uint32_t element_align;
+  std::uint64_t count;
+  std::uint64_t checksum;
+};
+static_assert(sizeof(header) == 32);
+
+// FNV-1a over every header field before the checksum.
+inline std::uint64_t checksum(const header &h) noexcept {
+  unsigned char bytes[offsetof(header, checksum)];
+  std::memcpy(bytes, &h, sizeof(bytes));
+  std::uint64_t hash = 0xcbf29ce484222325;
+  for (unsigned char byte : bytes) {
+    hash = (hash ^ byte) * 0x100000001b3;
+  }
+  return hash;
+}
+
+template <typename T> header make_header(std::uint64_t count) noexcept {
+  header h{};
+  h.magic = magic;
+  h.version = version;
+  h.header_size = sizeof(header);
+  h.element_size = sizeof(T);
+  h.element_align = alignof(T);
+  h.count = count;
+  h.checksum = checksum(h);
+  return h;
+}
+
+template <typename T> void check_header(const header &h) {
+  if (h.magic != magic || h.version != version ||
+      h.header_size != sizeof(header) || h.checksum != checksum(h)) {
+    throw std::runtime_error("Vector read. Not a vector dump of this version, "
+                             "or its header is corrupted.");
+  }
+  if (h.element_size != sizeof(T) || h.element_align != alignof(T)) {
+    throw std::runtime_error(
+        "Vector read. The element type does not match the dumped one.");
+  }
+}
+
+// Writes the header and `bytes` bytes at `data` with writev, so both go out
+// in one system call unless the kernel accepts less, in which case the rest
+// follows in further calls.
+inline void write_all(int fd, const header &h, const void *data,
+                      std::size_t bytes) {
+  iovec parts[2] = {
+      {const_cast<header *>(&h), sizeof(header)},
+      {const_cast<void *>(data), bytes},
+  };
+  iovec *part = parts;
+  int left = bytes > 0 ? 2 : 1;
+  while (left > 0) {
+    ssize_t written = ::writev(fd, part, left);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "Vector write");
+    }
+    std::size_t done = static_cast<std::size_t>(written);
+    while (left > 0 && done >= part->iov_len) {
+      done -= part->iov_len;
+      ++part;
+      --left;
+    }
+    if (left > 0) {
+      part->iov_base = static_cast<char *>(part->iov_base) + done;
+      part->iov_len -= done;
+    }
+  }
+}
+
+inline void write_all(std::ostream &out, const header &h, const void *data,
+                      std::size_t bytes) {
+  out.write(reinterpret_cast<const char *>(&h), sizeof(header));
+  out.write(static_cast<const char *>(data),
+            static_cast<std::streamsize>(bytes));
+  if (!out) {
+    throw std::runtime_error("Vector write. The stream refused the data.");
+  }
+}
+
+// Reads at most `bytes` bytes into `dst`; returns 0 only at end of input.
+inline std::size_t read_some(int fd, void *dst, std::size_t bytes) {
+  for (;;) {
+    ssize_t got = ::read(fd, dst, bytes);
+    if (got >= 0) {
+      return static_cast<std::size_t>(got);
+    }
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(), "Vector read");
+    }
+  }
+}
+
+inline std::size_t read_some(std::istream &in, void *dst, std::size_t bytes) {
+  in.read(static_cast<char *>(dst), static_cast<std::streamsize>(bytes));
+  if (in.bad()) {
+    throw std::runtime_error("Vector read. The stream failed.");
+  }
+  return static_cast<std::size_t>(in.gcount());
+}
+
+// Reads exactly `bytes` bytes or throws.
+template <typename Source>
+void read_exact(Source &source, void *dst, std::size_t bytes) {
+  char *at = static_cast<char *>(dst);
+  while (bytes > 0) {
+    std::size_t got = read_some(source, at, bytes);
+    if (got == 0) {
+      throw std::runtime_error("Vector read. The input ends too early.");
+    }
+    at += got;
+    bytes -= got;
+  }
+}
+}
+
+// Streams a dump written by s21::vector::write_to() into a vector one chunk
+// at a time. The header is read and checked on construction and the vector
+// reserved to the dumped size once; every read_chunk() then reads up to
+// `chunk_bytes` straight into the vector's storage, so the elements are
+// never staged in a buffer and never copied after they arrive. Between
+// chunks the elements loaded so far can already be used, and a pipe or
+// socket that delivers partial elements is handled.
+//
+//   s21::vector_reader<s21::vector<float>> reader(fd);
+//   while (reader.read_chunk()) {
+//     report(reader.loaded(), reader.size());
+//   }
+//   s21::vector<float> samples = std::move(reader).take();
+//
+// The input is a file descriptor or a std::istream.
+template <typename Vector> class vector_reader {
+public:
+  using value_type = typename Vector::value_type;
+  using size_type = typename Vector::size_type;
+
+  static_assert(std::is_trivially_copyable_v<value_type>,
+                "vector_reader needs a trivially copyable element type");
+
+  static constexpr std::size_t default_chunk_bytes = std::size_t{1} << 20;
+
+  // Reads into `into`, whose contents are discarded but whose storage is
+  // reused when it is large enough.
+  explicit vector_reader(int fd, Vector into = Vector(),
+                         std::size_t chunk_bytes = default_chunk_bytes)
+      : elements_(std::move(into)), fd_(fd), chunk_bytes_(chunk_bytes) {
+    start();
+  }
+
+  explicit vector_reader(std::istream &in, Vector into = Vector(),
+                         std::size_t chunk_bytes = default_chunk_bytes)
+      : elements_(std::move(into)), in_(&in), chunk_bytes_(chunk_bytes) {
+    start();
+  }
+
+  // Number of elements in the dump and number read so far.
+  size_type size() const noexcept { return total_; }
+  size_type loaded() const noexcept { return elements_.size(); }
+  bool done() const noexcept { return loaded() == total_; }
+
+  // The elements read so far.
+  const Vector &elements() const noexcept { return elements_; }
+
+  // Reads up to one chunk; returns false once every element has arrived.
+  // Throws if the input ends early.
+  bool read_chunk() {
+    if (done()) {
+      return false;
+    }
+    elements_.resize_and_overwrite(
+        total_, [this](value_type *data, size_type) {
+          std::size_t want = total_ * sizeof(value_type) - bytes_;
+          if (want > chunk_bytes_) {
+            want = chunk_bytes_;
+          }
+          char *dst = reinterpret_cast<char *>(data) + bytes_;
+          std::size_t got =
+              in_ ? vector_io::read_some(*in_, dst, want)
+                  : vector_io::read_some(fd_, dst, want);
+          if (got == 0) {
+            throw std::runtime_error("Vector read. The input ends too early.");
+          }
+          bytes_ += got;
+          return bytes_ / sizeof(value_type);
+        });
+    return true;
+  }
+
+  // Reads whatever is left and hands over the vector.
+  Vector take() && {
+    while (read_chunk()) {
+    }
+    return std::move(elements_);
+  }
+
+private:
+  Vector elements_;
+  int fd_ = -1;
+  std::istream *in_ = nullptr;
+  std::size_t chunk_bytes_;
+  size_type total_ = 0;
+  std::size_t bytes_ = 0;
+
+  void start() {
+    if (chunk_bytes_ < sizeof(value_type)) {
+      chunk_bytes_ = sizeof(value_type);
+    }
+    vector_io::header h;
+    if (in_) {
+      vector_io::read_exact(*in_, &h, sizeof(h));
+    } else {
+      vector_io::read_exact(fd_, &h, sizeof(h));
+    }
+    vector_io::check_header<value_type>(h);
+    if (h.count > std::numeric_limits<std::size_t>::max() / sizeof(value_type)) {
+      throw std::length_error("Vector read. The dump is too large.");
+    }
+    total_ = static_cast<size_type>(h.count);
+    elements_.clear();
+    elements_.reserve(total_);
+  }
+};
+
+}
+
+#endif
@@ -0,0 +1,372 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Throws from allocate() once `fail_after` more allocations have been made,
+// while armed.
+static int g_fail_after = -1;
+
+template <typename U> struct FailingAllocator : std::allocator<U> {
+  template <typename V> struct rebind {
+    using other = FailingAllocator<V>;
+  };
+  FailingAllocator() = default;
+  template <typename V> FailingAllocator(const FailingAllocator<V> &) {}
+  U *allocate(std::size_t n) {
+    if (g_fail_after == 0) {
+      throw std::bad_alloc();
+    }
+    if (g_fail_after > 0) {
+      --g_fail_after;
+    }
+    return std::allocator<U>::allocate(n);
+  }
+};
+
+// An int key whose copy constructor throws once `copies_left` more copies
+// have been made, while armed.
+struct FragileKey {
+  static inline int copies_left = -1;
+  int value;
+
+  FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (copies_left == 0) {
+      throw std::runtime_error("key copy");
+    }
+    if (copies_left > 0) {
+      --copies_left;
+    }
+  }
+  FragileKey(FragileKey &&) noexcept = default;
+  FragileKey &operator=(const FragileKey &) = default;
+  FragileKey &operator=(FragileKey &&) noexcept = default;
+  bool operator<(const FragileKey &other) const { return value < other.value; }
+};
+
+// Hands out memory from new/delete, counting live bytes, and fails the test
+// when asked to free a block it did not hand out.
+class TrackingResource : public std::pmr::memory_resource {
+public:
+  std::size_t live = 0;
+
+private:
+  std::set<void *> blocks_;
+
+  void *do_allocate(std::size_t bytes, std::size_t align) override {
+    void *p = std::pmr::new_delete_resource()->allocate(bytes, align);
+    blocks_.insert(p);
+    live += bytes;
+    return p;
+  }
+  void do_deallocate(void *p, std::size_t bytes, std::size_t align) override {
+    EXPECT_EQ(blocks_.erase(p), 1u) << "freed through the wrong resource";
+    live -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+using IntTree = s21::btree_map<int, int>;
+using StringTree = s21::btree_map<int, std::string>;
+
+// Compares contents and iteration in both directions against std::map.
+template <typename Tree, typename Oracle>
+void ExpectSameContents(Tree &tree, const Oracle &oracle) {
+  ASSERT_EQ(tree.size(), oracle.size());
+  auto it = tree.begin();
+  for (const auto &[key, value] : oracle) {
+    ASSERT_NE(it, tree.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(it, tree.end());
+  for (auto rit = oracle.rbegin(); rit != oracle.rend(); ++rit) {
+    --it;
+    EXPECT_EQ(it->first, rit->first);
+  }
+  EXPECT_EQ(it, tree.begin());
+}
+
+TEST(BTreeMapTest, StartsEmpty) {
+  IntTree tree;
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.size(), 0);
+  EXPECT_EQ(tree.begin(), tree.end());
+  EXPECT_EQ(tree.find(1), tree.end());
+  EXPECT_FALSE(tree.contains(1));
+  EXPECT_THROW(tree.at(1), std::out_of_range);
+  EXPECT_THROW(tree[1], std::out_of_range);
+}
+
+TEST(BTreeMapTest, InsertAndAccess) {
+  StringTree tree = {{2, "two"}, {1, "one"}, {3, "three"}};
+  EXPECT_EQ(tree.size(), 3);
+  EXPECT_EQ(tree.at(1), "one");
+  EXPECT_EQ(tree[3], "three");
+  tree[2] = "deux";
+  EXPECT_EQ(tree.at(2), "deux");
+
+  auto [pos, inserted] = tree.insert({2, "again"});
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(pos->second, "deux");
+
+  auto [assigned, fresh] = tree.insert_or_assign(2, "zwei");
+  EXPECT_FALSE(fresh);
+  EXPECT_EQ(assigned->second, "zwei");
+  EXPECT_TRUE(tree.insert_or_assign(4, "vier").second);
+  EXPECT_TRUE(tree.emplace(5, "five").second);
+  EXPECT_TRUE(tree.try_emplace(6, 3, 'x').second);
+  EXPECT_EQ(tree.at(6), "xxx");
+  EXPECT_EQ(tree.size(), 6);
+}
+
+TEST(BTreeMapTest, SortedAndReverseInsert) {
+  const int n = 5000;
+  IntTree ascending;
+  IntTree descending;
+  std::map<int, int> oracle;
+  for (int i = 0; i < n; ++i) {
+    ascending.insert(i, i * 2);
+    descending.insert(n - 1 - i, (n - 1 - i) * 2);
+    oracle.emplace(i, i * 2);
+  }
+  ExpectSameContents(ascending, oracle);
+  ExpectSameContents(descending, oracle);
+}
+
+TEST(BTreeMapTest, RandomInsertEraseMatchesStdMap) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> key_dist(0, 4000);
+  StringTree tree;
+  std::map<int, std::string> oracle;
+  for (int step = 0; step < 40000; ++step) {
+    int key = key_dist(rng);
+    if (rng() % 3 != 0) {
+      std::string value = std::to_string(key);
+      EXPECT_EQ(tree.insert({key, value}).second,
+                oracle.emplace(key, value).second);
+    } else {
+      auto it = tree.find(key);
+      EXPECT_EQ(it != tree.end(), oracle.erase(key) == 1);
+      tree.erase(it);
+    }
+  }
+  ExpectSameContents(tree, oracle);
+
+  while (!oracle.empty()) {
+    tree.erase(tree.find(oracle.begin()->first));
+    oracle.erase(oracle.begin());
+  }
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(BTreeMapTest, Bounds) {
+  IntTree tree;
+  for (int i = 0; i < 1000; i += 2) {
+    tree.insert(i, i);
+  }
+  EXPECT_EQ(tree.lower_bound(10)->first, 10);
+  EXPECT_EQ(tree.lower_bound(11)->first, 12);
+  EXPECT_EQ(tree.upper_bound(10)->first, 12);
+  EXPECT_EQ(tree.lower_bound(-5), tree.begin());
+  EXPECT_EQ(tree.lower_bound(998)->first, 998);
+  EXPECT_EQ(tree.upper_bound(998), tree.end());
+
+  auto [first, last] = tree.equal_range(500);
+  EXPECT_EQ(first->first, 500);
+  EXPECT_EQ(last->first, 502);
+  auto [lo, hi] = tree.equal_range(501);
+  EXPECT_EQ(lo, hi);
+
+  int visited = 0;
+  for (auto it = tree.lower_bound(100); it != tree.upper_bound(199); ++it) {
+    ++visited;
+  }
+  EXPECT_EQ(visited, 50);
+}
+
+TEST(BTreeMapTest, SortedUniqueBuild) {
+  for (int n : {0, 1, 7, 100, 1000, 54321}) {
+    std::vector<std::pair<int, int>> items;
+    std::map<int, int> oracle;
+    for (int i = 0; i < n; ++i) {
+      items.emplace_back(i * 3, i);
+      oracle.emplace(i * 3, i);
+    }
+    IntTree tree(s21::sorted_unique, items.begin(), items.end());
+    ExpectSameContents(tree, oracle);
+    for (int i = 0; i < n; i += 7) {
+      EXPECT_TRUE(tree.contains(i * 3));
+      EXPECT_FALSE(tree.contains(i * 3 + 1));
+    }
+    // The packed tree must stay valid under further edits.
+    for (int i = 0; i < n; i += 2) {
+      tree.erase(tree.find(i * 3));
+      oracle.erase(i * 3);
+      tree.insert(i * 3 + 1, -i);
+      oracle.emplace(i * 3 + 1, -i);
+    }
+    ExpectSameContents(tree, oracle);
+  }
+}
+
+TEST(BTreeMapTest, CopyAndMove) {
+  StringTree tree;
+  for (int i = 0; i < 2000; ++i) {
+    tree.insert(i, std::to_string(i));
+  }
+  StringTree copy(tree);
+  copy[5] = "changed";
+  EXPECT_EQ(tree[5], "5");
+  EXPECT_EQ(copy.size(), tree.size());
+
+  StringTree moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved[5], "changed");
+
+  StringTree assigned;
+  assigned = tree;
+  EXPECT_EQ(assigned.size(), 2000);
+  assigned = std::move(moved);
+  EXPECT_EQ(assigned[5], "changed");
+  EXPECT_EQ(assigned[1999], "1999");
+}
+
+TEST(BTreeMapTest, MergeMovesAbsentKeys) {
+  StringTree target = {{1, "a"}, {3, "c"}};
+  StringTree source = {{1, "x"}, {2, "b"}, {4, "d"}};
+  target.merge(source);
+  EXPECT_EQ(target.size(), 4);
+  EXPECT_EQ(target[1], "a");
+  EXPECT_EQ(target[2], "b");
+  EXPECT_EQ(target[4], "d");
+  ASSERT_EQ(source.size(), 1);
+  EXPECT_EQ(source[1], "x");
+}
+
+TEST(BTreeMapTest, ClearAndReuse) {
+  IntTree tree;
+  for (int i = 0; i < 3000; ++i) {
+    tree.insert(i, i);
+  }
+  tree.clear();
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.begin(), tree.end());
+  tree.insert(7, 7);
+  EXPECT_EQ(tree.at(7), 7);
+}
+
+TEST(BTreeMapTest, PoolAllocatedNodes) {
+  s21::btree_map<int, int, s21::pool_allocator<std::pair<const int, int>>> tree;
+  std::map<int, int> oracle;
+  for (int i = 0; i < 3000; ++i) {
+    tree.insert((i * 7919) % 3000, i);
+    oracle.emplace((i * 7919) % 3000, i);
+  }
+  for (int i = 0; i < 3000; i += 3) {
+    tree.erase(tree.find(i));
+    oracle.erase(i);
+  }
+  ExpectSameContents(tree, oracle);
+}
+
+// Every insert runs out of memory on its second allocation, which hits
+// each kind of split: a leaf with a new root, a leaf under a non-full
+// parent, and splits climbing through full ancestors.
+TEST(BTreeMapTest, FailedSplitLeavesTreeIntact) {
+  s21::btree_map<int, int, FailingAllocator<std::pair<const int, int>>> tree;
+  std::map<int, int> oracle;
+  for (int i = 0; i < 3000; ++i) {
+    int key = (i * 7919) % 3000;
+    g_fail_after = 1;
+    try {
+      tree.insert(key, i);
+      oracle.emplace(key, i);
+    } catch (const std::bad_alloc &) {
+    }
+    g_fail_after = -1;
+    ASSERT_EQ(tree.size(), oracle.size());
+    tree.insert(key, i);
+    oracle.emplace(key, i);
+  }
+  ExpectSameContents(tree, oracle);
+  for (const auto &[key, value] : oracle) {
+    ASSERT_EQ(tree.at(key), value) << key;
+  }
+}
+
+// Keys go in ascending order, so inserts that split copy the separator and
+// then every key moved to the new leaf; failing the i % 16-th copy throws
+// from each of those steps in turn.
+TEST(BTreeMapTest, ThrowingKeyCopyLeavesTreeIntact) {
+  s21::btree_map<FragileKey, int> tree;
+  for (int i = 0; i < 2000; ++i) {
+    FragileKey::copies_left = i % 16;
+    try {
+      tree.insert(FragileKey(i), i);
+    } catch (const std::runtime_error &) {
+    }
+    FragileKey::copies_left = -1;
+    if (!tree.contains(FragileKey(i))) {
+      tree.insert(FragileKey(i), i);
+    }
+    ASSERT_EQ(tree.size(), i + 1);
+  }
+  for (int i = 0; i < 2000; ++i) {
+    ASSERT_EQ(tree.at(FragileKey(i)), i) << i;
+  }
+  int expected = 0;
+  for (auto it = tree.begin(); it != tree.end(); ++it) {
+    ASSERT_EQ(it->first.value, expected++);
+  }
+  EXPECT_EQ(expected, 2000);
+}
+
+// polymorphic_allocator does not propagate on move assignment, so a map
+// moved from one resource into a map on another must keep its own.
+TEST(BTreeMapTest, MoveAssignAcrossResources) {
+  using PmrTree =
+      s21::btree_map<int, std::string,
+                     std::pmr::polymorphic_allocator<
+                         std::pair<const int, std::string>>>;
+  TrackingResource first;
+  TrackingResource second;
+  {
+    std::pmr::memory_resource *old = std::pmr::set_default_resource(&first);
+    PmrTree source;
+    std::pmr::set_default_resource(&second);
+    PmrTree target = {{-1, "gone"}};
+    std::pmr::set_default_resource(old);
+    for (int i = 0; i < 1000; ++i) {
+      source.insert(i, std::to_string(i));
+    }
+
+    target = std::move(source);
+    EXPECT_TRUE(source.empty());
+    ASSERT_EQ(target.size(), 1000);
+    EXPECT_FALSE(target.contains(-1));
+    EXPECT_EQ(target[999], "999");
+    EXPECT_EQ(first.live, 0u);
+    target.insert(1000, "1000");
+    source.insert(1, "1");
+  }
+  EXPECT_EQ(first.live, 0u);
+  EXPECT_EQ(second.live, 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
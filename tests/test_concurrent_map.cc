@@ -0,0 +1,142 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentMapTest, ShardCountIsPowerOfTwo) {
+  s21::concurrent_map<int, int> map(10);
+  EXPECT_EQ(map.shard_count(), 16);
+  s21::concurrent_map<int, int> single(1);
+  EXPECT_EQ(single.shard_count(), 1);
+  single.insert(1, 1);
+  EXPECT_TRUE(single.contains(1));
+}
+
+TEST(ConcurrentMapTest, PointOperations) {
+  s21::concurrent_map<int, std::string> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.find(1).has_value());
+  EXPECT_THROW(map.at(1), std::out_of_range);
+
+  EXPECT_TRUE(map.insert(1, "one"));
+  EXPECT_FALSE(map.insert({1, "uno"}));
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_TRUE(map.try_emplace(2, 3, 'b'));
+  EXPECT_EQ(*map.find(2), "bbb");
+
+  EXPECT_FALSE(map.insert_or_assign(1, "eins"));
+  EXPECT_TRUE(map.insert_or_assign(3, "drei"));
+  EXPECT_EQ(map.at(1), "eins");
+
+  EXPECT_TRUE(map.update(3, [](std::string &value) { value += "!"; }));
+  EXPECT_FALSE(map.update(4, [](std::string &) {}));
+  EXPECT_EQ(map.at(3), "drei!");
+
+  EXPECT_EQ(map.erase(2), 1);
+  EXPECT_EQ(map.erase(2), 0);
+  EXPECT_EQ(map.size(), 2);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(ConcurrentMapTest, SnapshotIsOrderedAcrossShards) {
+  s21::concurrent_map<int, int> map(8);
+  std::map<int, int> oracle;
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 7919) % 10007;
+    map.insert(key, i);
+    oracle.emplace(key, i);
+  }
+  auto snapshot = map.snapshot();
+  ASSERT_EQ(snapshot.size(), oracle.size());
+  auto it = snapshot.begin();
+  for (const auto &[key, value] : oracle) {
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+
+  std::vector<int> visited;
+  map.for_each([&](const int &key, const int &) { visited.push_back(key); });
+  EXPECT_EQ(visited.size(), oracle.size());
+  EXPECT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+}
+
+// Each writer inserts its own keys in increasing order while a reader takes
+// snapshots. A point-in-time copy across all shards must hold a prefix of
+// every writer's sequence: seeing a key without all of its predecessors
+// would mean the shards were copied at different moments. Run under
+// ThreadSanitizer by `make tsan`.
+TEST(ConcurrentMapStressTest, SnapshotsAreConsistent) {
+  constexpr int writers = 4;
+  constexpr int per_writer = 5000;
+  s21::concurrent_map<int, int> map(16);
+  std::atomic<int> done{0};
+  std::atomic<bool> consistent{true};
+  std::atomic<int> snapshots{0};
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; ++w) {
+    threads.emplace_back([&, w] {
+      for (int i = 0; i < per_writer; ++i) {
+        map.insert(w * per_writer + i, i);
+      }
+      done.fetch_add(1);
+    });
+  }
+  threads.emplace_back([&] {
+    do {
+      auto snapshot = map.snapshot();
+      std::vector<int> seen(writers, 0);
+      for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+        int writer = it->first / per_writer;
+        if (it->second != seen[writer]++) {
+          consistent = false;
+        }
+      }
+      snapshots.fetch_add(1);
+      std::this_thread::yield();
+    } while (done.load() < writers);
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(consistent);
+  EXPECT_GT(snapshots.load(), 0);
+  EXPECT_EQ(map.size(), writers * per_writer);
+}
+
+TEST(ConcurrentMapStressTest, DisjointWritersAndReaders) {
+  constexpr int threads_count = 8;
+  constexpr int per_thread = 5000;
+  s21::concurrent_map<int, int> map;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        int key = t * per_thread + i;
+        map.insert(key, key);
+        if (map.find(key).value_or(-1) != key) {
+          ADD_FAILURE() << "lost key " << key;
+        }
+        if (i % 2) {
+          map.erase(key);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(map.size(), threads_count * per_thread / 2);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,166 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using IntFlatMap = s21::flat_map<int, int>;
+using StringFlatMap = s21::flat_map<int, std::string>;
+
+template <typename Map, typename Oracle>
+void ExpectSameContents(Map &map, const Oracle &oracle) {
+  ASSERT_EQ(map.size(), oracle.size());
+  auto it = map.begin();
+  for (const auto &[key, value] : oracle) {
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(it, map.end());
+}
+
+TEST(FlatMapTest, StartsEmpty) {
+  IntFlatMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(3), map.end());
+  EXPECT_EQ(map.lower_bound(3), map.end());
+  EXPECT_FALSE(map.contains(3));
+  EXPECT_THROW(map.at(3), std::out_of_range);
+}
+
+TEST(FlatMapTest, RangeBuildSortsAndKeepsFirstDuplicate) {
+  std::vector<std::pair<int, std::string>> input = {
+      {5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}, {5, "cinq"}};
+  StringFlatMap map(input.begin(), input.end());
+  ASSERT_EQ(map.size(), 3);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_EQ(map.at(3), "three");
+  EXPECT_EQ(map.at(5), "five");
+  EXPECT_TRUE(std::is_sorted(map.keys().begin(), map.keys().end()));
+}
+
+TEST(FlatMapTest, SortedUniqueForms) {
+  StringFlatMap from_list(s21::sorted_unique, {{1, "a"}, {2, "b"}, {4, "d"}});
+  EXPECT_EQ(from_list.size(), 3);
+  EXPECT_EQ(from_list[4], "d");
+
+  s21::vector<int> keys = {1, 2, 3};
+  s21::vector<std::string> values = {"x", "y", "z"};
+  StringFlatMap adopted(s21::sorted_unique, std::move(keys), std::move(values));
+  EXPECT_EQ(adopted.at(2), "y");
+
+  s21::vector<int> short_keys = {1};
+  s21::vector<std::string> long_values = {"x", "y"};
+  EXPECT_THROW(StringFlatMap(s21::sorted_unique, std::move(short_keys),
+                             std::move(long_values)),
+               std::invalid_argument);
+}
+
+TEST(FlatMapTest, InsertAssignAndErase) {
+  StringFlatMap map = {{2, "two"}};
+  EXPECT_TRUE(map.insert({1, "one"}).second);
+  EXPECT_FALSE(map.insert(1, "uno").second);
+  EXPECT_TRUE(map.emplace(3, "three").second);
+  EXPECT_TRUE(map.try_emplace(4, 2, '4').second);
+  EXPECT_FALSE(map.insert_or_assign(2, "deux").second);
+  EXPECT_TRUE(map.insert_or_assign(0, "zero").second);
+  EXPECT_EQ(map.at(2), "deux");
+  EXPECT_EQ(map.at(4), "44");
+
+  map.erase(map.find(2));
+  map.erase(map.end());
+  std::map<int, std::string> oracle = {
+      {0, "zero"}, {1, "one"}, {3, "three"}, {4, "44"}};
+  ExpectSameContents(map, oracle);
+}
+
+TEST(FlatMapTest, RandomOpsMatchStdMap) {
+  std::mt19937 rng(11);
+  IntFlatMap map;
+  std::map<int, int> oracle;
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(rng() % 3000);
+    if (rng() % 3 != 0) {
+      EXPECT_EQ(map.insert(key, step).second, oracle.emplace(key, step).second);
+    } else {
+      auto it = map.find(key);
+      EXPECT_EQ(it != map.end(), oracle.erase(key) == 1);
+      map.erase(it);
+    }
+  }
+  ExpectSameContents(map, oracle);
+}
+
+TEST(FlatMapTest, BoundsMatchStdMap) {
+  std::map<int, int> oracle;
+  for (int i = 0; i < 257; ++i) {
+    oracle.emplace(i * 4, i);
+  }
+  IntFlatMap map(oracle.begin(), oracle.end());
+  for (int key = -3; key < 1040; ++key) {
+    auto lower = oracle.lower_bound(key);
+    auto upper = oracle.upper_bound(key);
+    EXPECT_EQ(map.lower_bound(key) - map.begin(),
+              std::distance(oracle.begin(), lower));
+    EXPECT_EQ(map.upper_bound(key) - map.begin(),
+              std::distance(oracle.begin(), upper));
+    EXPECT_EQ(map.contains(key), oracle.count(key) == 1);
+  }
+  auto [first, last] = map.equal_range(40);
+  EXPECT_EQ(last - first, 1);
+  EXPECT_EQ(first->second, 10);
+}
+
+TEST(FlatMapTest, IteratorIsRandomAccess) {
+  IntFlatMap map = {{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  auto it = map.begin();
+  EXPECT_EQ((it + 2)->first, 3);
+  EXPECT_EQ(it[3].second, 40);
+  EXPECT_EQ(map.end() - map.begin(), 4);
+  auto last = map.end();
+  --last;
+  EXPECT_EQ(last->first, 4);
+  EXPECT_LT(it, last);
+  (*it).second = 11;
+  it->second += 1;
+  EXPECT_EQ(map.at(1), 12);
+}
+
+TEST(FlatMapTest, MergeKeepsExistingKeys) {
+  StringFlatMap target = {{1, "a"}, {3, "c"}, {5, "e"}};
+  StringFlatMap source = {{0, "z"}, {3, "x"}, {4, "d"}, {9, "i"}};
+  target.merge(source);
+  std::map<int, std::string> expected = {
+      {0, "z"}, {1, "a"}, {3, "c"}, {4, "d"}, {5, "e"}, {9, "i"}};
+  ExpectSameContents(target, expected);
+  ASSERT_EQ(source.size(), 1);
+  EXPECT_EQ(source.at(3), "x");
+}
+
+TEST(FlatMapTest, CopyAndMove) {
+  StringFlatMap map = {{1, "one"}, {2, "two"}};
+  StringFlatMap copy(map);
+  copy[1] = "changed";
+  EXPECT_EQ(map[1], "one");
+
+  StringFlatMap moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved[1], "changed");
+
+  map = moved;
+  EXPECT_EQ(map[1], "changed");
+  map = {{7, "seven"}};
+  EXPECT_EQ(map.size(), 1);
+  moved = std::move(map);
+  EXPECT_EQ(moved[7], "seven");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
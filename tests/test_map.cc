@@ -25,6 +25,46 @@ public:
     }
 };
 
+// Test-only red-black invariant checker. Recurses down from `node` and
+// checks that every child links back to its parent, that keys are ordered
+// around each node and that no red node has a red child. Returns the
+// subtree's black height (null leaves count as 1), or -1 if a rule is
+// broken or the two sides' black heights differ.
+template <typename NodePtr> int CheckSubtree(NodePtr node, NodePtr parent) {
+    if (!node) return 1;
+    if (node->parent != parent) return -1;
+    if (node->left && !(node->left->data.first < node->data.first)) return -1;
+    if (node->right && !(node->data.first < node->right->data.first)) return -1;
+    if (!node->is_black &&
+        ((node->left && !node->left->is_black) ||
+         (node->right && !node->right->is_black)))
+        return -1;
+    int left = CheckSubtree(node->left, node);
+    int right = CheckSubtree(node->right, node);
+    if (left < 0 || right < 0 || left != right) return -1;
+    return left + (node->is_black ? 1 : 0);
+}
+
+// Walks up from the leftmost node to the root, checks that the root is
+// black and returns the tree's black height, or -1 if any rule is broken.
+template <typename Map> int BlackHeight(Map &map) {
+    auto node = map.begin().current;
+    if (!node) return 0;
+    while (node->parent) node = node->parent;
+    if (!node->is_black) return -1;
+    return CheckSubtree(node, decltype(node){nullptr});
+}
+
+template <typename Map> int TreeHeight(Map &map) {
+    auto node = map.begin().current;
+    if (!node) return 0;
+    while (node->parent) node = node->parent;
+    auto height = [](auto &self, decltype(node) n) -> int {
+        return n ? 1 + std::max(self(self, n->left), self(self, n->right)) : 0;
+    };
+    return height(height, node);
+}
+
 TEST(MyMapTest, ExistingKeyAccess) {
     s21::map<std::string, Person> map;
     
@@ -168,6 +208,444 @@ TEST(MyMapTest, EraseNodeWithTwoChildren) {
     EXPECT_EQ((++it)->first, 10); 
 }
 
+TEST(MyMapBalanceTest, SortedInsertStaysBalanced) {
+    s21::map<int, int> map;
+    const int N = 4096;
+    for (int i = 0; i < N; ++i) {
+        map.insert({i, i});
+        ASSERT_GT(BlackHeight(map), 0);
+    }
+    EXPECT_EQ(map.size(), N);
+    EXPECT_LE(TreeHeight(map), 2 * 13);
+}
+
+TEST(MyMapBalanceTest, ReverseInsertStaysBalanced) {
+    s21::map<int, int> map;
+    const int N = 4096;
+    for (int i = N; i > 0; --i) {
+        map.insert({i, i});
+        ASSERT_GT(BlackHeight(map), 0);
+    }
+    EXPECT_LE(TreeHeight(map), 2 * 13);
+}
+
+TEST(MyMapBalanceTest, RandomInsertEraseKeepsInvariants) {
+    s21::map<int, int> map;
+    std::vector<int> keys(2000);
+    for (int i = 0; i < 2000; ++i) keys[i] = (i * 7919) % 2003;
+    for (int key : keys) {
+        map.insert({key, key});
+        ASSERT_GT(BlackHeight(map), 0);
+    }
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        auto it = map.begin();
+        while (it->first != keys[i]) ++it;
+        map.erase(it);
+        ASSERT_GE(BlackHeight(map), 0);
+        EXPECT_FALSE(map.contains(keys[i]));
+    }
+    EXPECT_EQ(map.size(), keys.size() / 2);
+    EXPECT_LE(TreeHeight(map), 2 * 11);
+}
+
+TEST(MyMapBalanceTest, EraseSortedFromFront) {
+    s21::map<int, int> map;
+    for (int i = 0; i < 1024; ++i) map.insert({i, i});
+    for (int i = 0; i < 1024; ++i) {
+        EXPECT_EQ(map.begin()->first, i);
+        map.erase(map.begin());
+        ASSERT_GE(BlackHeight(map), 0);
+    }
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(MyMapBalanceTest, MergeKeepsInvariants) {
+    s21::map<int, int> a;
+    s21::map<int, int> b;
+    for (int i = 0; i < 256; ++i) {
+        a.insert({2 * i, i});
+        b.insert({i, i});
+    }
+    a.merge(b);
+    EXPECT_EQ(a.size(), 384);
+    EXPECT_EQ(b.size(), 128);
+    EXPECT_GT(BlackHeight(a), 0);
+    EXPECT_GT(BlackHeight(b), 0);
+}
+
+TEST(MyMapRangeTest, FindReturnsIterator) {
+    s21::map<int, std::string> map = {{1, "one"}, {2, "two"}, {3, "three"}};
+    auto it = map.find(2);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, "two");
+    EXPECT_EQ(map.find(4), map.end());
+
+    map.erase(map.find(1));
+    EXPECT_FALSE(map.contains(1));
+}
+
+TEST(MyMapRangeTest, LowerAndUpperBound) {
+    s21::map<int, int> map;
+    for (int i = 0; i < 100; i += 10) map.insert({i, i});
+
+    EXPECT_EQ(map.lower_bound(30)->first, 30);
+    EXPECT_EQ(map.upper_bound(30)->first, 40);
+    EXPECT_EQ(map.lower_bound(31)->first, 40);
+    EXPECT_EQ(map.upper_bound(31)->first, 40);
+    EXPECT_EQ(map.lower_bound(-5), map.begin());
+    EXPECT_EQ(map.lower_bound(91), map.end());
+    EXPECT_EQ(map.upper_bound(90), map.end());
+}
+
+TEST(MyMapRangeTest, EqualRange) {
+    s21::map<int, char> map = {{1, 'a'}, {3, 'c'}, {5, 'e'}};
+    auto [first, last] = map.equal_range(3);
+    ASSERT_NE(first, map.end());
+    EXPECT_EQ(first->second, 'c');
+    EXPECT_EQ(last->first, 5);
+
+    auto [lo, hi] = map.equal_range(4);
+    EXPECT_EQ(lo, hi);
+    EXPECT_EQ(lo->first, 5);
+}
+
+TEST(MyMapRangeTest, HalfOpenWindowScan) {
+    s21::map<int, int> map;
+    for (int i = 0; i < 1000; ++i) map.insert({i, i * i});
+
+    std::vector<int> keys;
+    for (auto it = map.lower_bound(100), stop = map.lower_bound(110);
+         it != stop; ++it)
+        keys.push_back(it->first);
+
+    ASSERT_EQ(keys.size(), 10);
+    EXPECT_EQ(keys.front(), 100);
+    EXPECT_EQ(keys.back(), 109);
+}
+
+TEST(MyMapRangeTest, IteratorsAreDecrementable) {
+    s21::map<int, int> map;
+    for (int i = 0; i < 50; ++i) map.insert({(i * 17) % 50, i});
+
+    auto it = map.end();
+    for (int expected = 49; expected >= 0; --expected) {
+        --it;
+        ASSERT_EQ(it->first, expected);
+    }
+    EXPECT_EQ(it, map.begin());
+
+    auto last = std::prev(map.end());
+    EXPECT_EQ(last->first, 49);
+    EXPECT_EQ((last--)->first, 49);
+    EXPECT_EQ(last->first, 48);
+    EXPECT_EQ(std::next(last), std::prev(map.end()));
+}
+
+static int g_node_allocations = 0;
+
+template <typename U> struct CountingAllocator : std::allocator<U> {
+    template <typename V> struct rebind { using other = CountingAllocator<V>; };
+    CountingAllocator() = default;
+    template <typename V> CountingAllocator(const CountingAllocator<V> &) {}
+    U *allocate(std::size_t n) {
+        ++g_node_allocations;
+        return std::allocator<U>::allocate(n);
+    }
+};
+
+struct Blob {
+    static int copies;
+    std::vector<int> bytes;
+    Blob() = default;
+    explicit Blob(int n) : bytes(n, n) {}
+    Blob(const Blob &other) : bytes(other.bytes) { ++copies; }
+    Blob(Blob &&other) noexcept = default;
+    Blob &operator=(const Blob &other) {
+        bytes = other.bytes;
+        ++copies;
+        return *this;
+    }
+    Blob &operator=(Blob &&other) noexcept = default;
+};
+int Blob::copies = 0;
+
+using CountingMap =
+    s21::map<int, Blob, CountingAllocator<std::pair<const int, Blob>>>;
+
+TEST(MyMapInsertTest, RvalueInsertDoesNotCopy) {
+    CountingMap map;
+    Blob::copies = 0;
+    map.insert({1, Blob(64)});
+    map.insert(std::pair<const int, Blob>(2, Blob(64)));
+    map.emplace(3, Blob(64));
+    map.try_emplace(4, 64);
+    map.insert_or_assign(4, Blob(8));
+    EXPECT_EQ(Blob::copies, 0);
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.at(4).bytes.size(), 8);
+}
+
+TEST(MyMapInsertTest, ExistingKeyAllocatesNothing) {
+    CountingMap map;
+    map.try_emplace(1, 16);
+    g_node_allocations = 0;
+
+    Blob blob(32);
+    auto [it, inserted] = map.try_emplace(1, std::move(blob));
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(blob.bytes.size(), 32);
+    map.insert({1, Blob(8)});
+    map.emplace(1, Blob(8));
+    map.insert_or_assign(1, Blob(4));
+    EXPECT_EQ(g_node_allocations, 0);
+    EXPECT_EQ(map.at(1).bytes.size(), 4);
+}
+
+TEST(MyMapInsertTest, EmplaceConstructsFromPieces) {
+    s21::map<std::string, std::string> map;
+    auto [it, inserted] = map.emplace("key", "value");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->second, "value");
+
+    auto [dup, again] = map.emplace(std::piecewise_construct,
+                                    std::forward_as_tuple("key"),
+                                    std::forward_as_tuple(3, 'x'));
+    EXPECT_FALSE(again);
+    EXPECT_EQ(dup->second, "value");
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST(MyMapInsertTest, HintedInsertKeepsOrderAndBalance) {
+    s21::map<int, int> map;
+    for (int i = 0; i < 1000; ++i) map.insert(map.end(), {i, i});
+    for (int i = 1999; i >= 1000; --i) map.emplace_hint(map.find(i + 1), i, i);
+    map.try_emplace(map.begin(), 500, -1);
+    map.insert(map.find(10), {-5, -5});
+
+    EXPECT_EQ(map.size(), 2001);
+    EXPECT_EQ(map.at(500), 500);
+    EXPECT_GT(BlackHeight(map), 0);
+    int expected = -5;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        ASSERT_EQ(it->first, expected);
+        expected = expected == -5 ? 0 : expected + 1;
+    }
+}
+
+// Descending keys hinted at begin(): each one lands before the leftmost
+// node.
+TEST(MyMapInsertTest, HintedInsertAtBegin) {
+    s21::map<int, int> map;
+    for (int i = 999; i >= 0; --i) map.insert(map.begin(), {i, i});
+    map.insert(map.begin(), {500, -1});
+
+    EXPECT_EQ(map.size(), 1000);
+    EXPECT_EQ(map.at(500), 500);
+    EXPECT_GT(BlackHeight(map), 0);
+    int expected = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        ASSERT_EQ(it->first, expected++);
+    }
+}
+
+TEST(MyMapNodeTest, ExtractAndReinsert) {
+    s21::map<int, std::string> map = {{1, "a"}, {2, "b"}, {3, "c"}};
+    const std::string *value = &map.at(2);
+
+    auto nh = map.extract(2);
+    ASSERT_FALSE(nh.empty());
+    EXPECT_EQ(nh.key(), 2);
+    EXPECT_EQ(&nh.mapped(), value);
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_FALSE(map.contains(2));
+    EXPECT_GT(BlackHeight(map), 0);
+
+    EXPECT_TRUE(map.extract(42).empty());
+
+    auto result = map.insert(std::move(nh));
+    EXPECT_TRUE(result.inserted);
+    EXPECT_TRUE(result.node.empty());
+    EXPECT_EQ(&result.position->second, value);
+    EXPECT_EQ(map.size(), 3);
+}
+
+TEST(MyMapNodeTest, DuplicateKeyReturnsHandle) {
+    s21::map<int, std::string> map = {{1, "a"}};
+    s21::map<int, std::string> other = {{1, "z"}};
+
+    auto result = map.insert(other.extract(other.begin()));
+    EXPECT_FALSE(result.inserted);
+    ASSERT_FALSE(result.node.empty());
+    EXPECT_EQ(result.node.mapped(), "z");
+    EXPECT_EQ(result.position->second, "a");
+}
+
+TEST(MyMapNodeTest, HandleOutlivesSourceMap) {
+    s21::map<int, std::string> target;
+    {
+        s21::map<int, std::string> source = {{7, std::string(100, 'x')}};
+        auto nh = source.extract(7);
+        source.clear();
+        source.insert({8, "y"});
+        target.insert(std::move(nh));
+    }
+    EXPECT_EQ(target.at(7).size(), 100);
+}
+
+TEST(MyMapNodeTest, MergeRelinksWithoutAllocating) {
+    CountingMap a;
+    CountingMap b;
+    for (int i = 0; i < 100; ++i) {
+        a.try_emplace(2 * i, 1);
+        b.try_emplace(3 * i, 1);
+    }
+    const Blob *moved = &b.at(3);
+    g_node_allocations = 0;
+    Blob::copies = 0;
+
+    a.merge(b);
+    EXPECT_EQ(g_node_allocations, 0);
+    EXPECT_EQ(Blob::copies, 0);
+    EXPECT_EQ(&a.at(3), moved);
+    EXPECT_EQ(a.size() + b.size(), 200);
+    EXPECT_EQ(b.size(), 34);
+    EXPECT_GT(BlackHeight(a), 0);
+    EXPECT_GT(BlackHeight(b), 0);
+    for (auto it = b.begin(); it != b.end(); ++it)
+        EXPECT_EQ(it->first % 6, 0);
+}
+
+TEST(MyMapNodeTest, MergeSmallIntoLarge) {
+    s21::map<int, int> a;
+    s21::map<int, int> b = {{-1, -1}, {5, 0}, {5000, 5000}};
+    for (int i = 0; i < 4096; ++i) a.insert({i, i});
+    a.merge(b);
+    EXPECT_EQ(a.size(), 4098);
+    EXPECT_EQ(b.size(), 1);
+    EXPECT_EQ(b.begin()->first, 5);
+    EXPECT_EQ(a.begin()->first, -1);
+    EXPECT_EQ(std::prev(a.end())->first, 5000);
+    EXPECT_GT(BlackHeight(a), 0);
+}
+
+TEST(MyMapNodeTest, MergeDisjointRanges) {
+    for (int n : {0, 1, 2, 3, 7, 8, 100, 1023}) {
+        s21::map<int, int> low;
+        s21::map<int, int> high;
+        for (int i = 0; i < n; ++i) {
+            low.insert({i, i});
+            high.insert({n + i, i});
+        }
+        high.merge(low);
+        ASSERT_EQ(high.size(), 2 * n);
+        EXPECT_TRUE(low.empty());
+        ASSERT_GE(BlackHeight(high), 0);
+        int expected = 0;
+        for (auto it = high.begin(); it != high.end(); ++it)
+            ASSERT_EQ(it->first, expected++);
+    }
+}
+
+TEST(MyMapNodeTest, MergeFromSharedPoolMovesValues) {
+    s21::map<int, std::string> a = {{1, "a"}};
+    s21::map<int, std::string> b = {{2, "b"}, {3, "c"}};
+    auto held = b.extract(3);
+
+    a.merge(b);
+    EXPECT_EQ(a.size(), 2);
+    EXPECT_EQ(a.at(2), "b");
+    EXPECT_TRUE(b.empty());
+    a.insert(std::move(held));
+    EXPECT_EQ(a.at(3), "c");
+}
+
+TEST(MyMapNodeTest, InsertRelinksNodeFromAnotherPool) {
+    s21::map<int, std::string> a = {{1, "a"}, {2, "b"}};
+    s21::map<int, std::string> b = {{3, "c"}};
+    const std::string *value = &a.at(2);
+
+    auto nh = a.extract(2);
+    auto result = b.insert(std::move(nh));
+    EXPECT_TRUE(result.inserted);
+    EXPECT_TRUE(nh.empty());
+    EXPECT_EQ(&result.position->second, value);
+
+    a.clear();
+    a.insert({4, "d"});
+    EXPECT_EQ(b.at(2), "b");
+    EXPECT_EQ(b.size(), 2);
+}
+
+TEST(MyMapNodeTest, InsertMovesValueWhenPoolsStaySeparate) {
+    s21::map<int, std::string> a = {{1, "a"}, {2, std::string(100, 'b')}};
+    s21::map<int, std::string> b = {{3, "c"}, {4, "d"}};
+    auto held_a = a.extract(1);
+    auto held_b = b.extract(4);
+
+    auto nh = a.extract(2);
+    auto result = b.insert(std::move(nh));
+    EXPECT_TRUE(result.inserted);
+    EXPECT_TRUE(nh.empty());
+    EXPECT_EQ(b.at(2), std::string(100, 'b'));
+}
+
+TEST(MyMapBulkTest, SortedUniqueBuildsBalancedTree) {
+    for (int n : {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 31, 32, 33, 1000}) {
+        std::vector<std::pair<const int, int>> input;
+        for (int i = 0; i < n; ++i) input.emplace_back(i, -i);
+        s21::map<int, int> map(s21::sorted_unique, input.begin(), input.end());
+        ASSERT_EQ(map.size(), n);
+        ASSERT_GE(BlackHeight(map), 0) << n;
+        int expected = 0;
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            ASSERT_EQ(it->first, expected);
+            ASSERT_EQ(it->second, -expected);
+            ++expected;
+        }
+        map.insert({n, 0});
+        map.erase(map.begin());
+        ASSERT_GE(BlackHeight(map), 0);
+    }
+}
+
+TEST(MyMapBulkTest, SortedUniqueNodesAreContiguous) {
+    std::vector<std::pair<const int, int>> input;
+    for (int i = 0; i < 5000; ++i) input.emplace_back(i, i);
+    s21::map<int, int> map(s21::sorted_unique, input.begin(), input.end());
+
+    auto it = map.begin();
+    auto *prev = it.current;
+    for (++it; it != map.end(); ++it) {
+        ASSERT_EQ(it.current, prev + 1);
+        prev = it.current;
+    }
+}
+
+TEST(MyMapBulkTest, RangeConstructorDetectsSortedPrefix) {
+    std::vector<std::pair<const int, std::string>> input;
+    for (int i = 0; i < 100; ++i) input.emplace_back(i, std::to_string(i));
+    input.emplace_back(50, "dup");
+    input.emplace_back(-1, "neg");
+    input.emplace_back(200, "tail");
+
+    s21::map<int, std::string> map(input.begin(), input.end());
+    EXPECT_EQ(map.size(), 102);
+    EXPECT_EQ(map.at(50), "50");
+    EXPECT_EQ(map.begin()->second, "neg");
+    EXPECT_GT(BlackHeight(map), 0);
+}
+
+TEST(MyMapBulkTest, InitializerListForms) {
+    s21::map<int, char> map(s21::sorted_unique, {{1, 'a'}, {2, 'b'}, {4, 'd'}});
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_GT(BlackHeight(map), 0);
+
+    map = {{9, 'z'}, {3, 'c'}, {3, 'x'}};
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(3), 'c');
+    EXPECT_GT(BlackHeight(map), 0);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
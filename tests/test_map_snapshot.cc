@@ -0,0 +1,268 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+// Each test saves to its own snapshot file in gtest's temp directory and
+// deletes it afterwards, along with the ".tmp" file save() writes first.
+class MapSnapshotTest : public ::testing::Test {
+protected:
+  std::string path = SnapshotPath();
+
+  void TearDown() override {
+    std::remove(path.c_str());
+    std::remove((path + ".tmp").c_str());
+  }
+
+private:
+  static std::string SnapshotPath() {
+    const auto *test = ::testing::UnitTest::GetInstance()->current_test_info();
+    return ::testing::TempDir() + "s21_map_snapshot_" +
+           std::to_string(::getpid()) + "_" + test->name();
+  }
+};
+
+TEST_F(MapSnapshotTest, MappedFindsEveryKey) {
+  s21::map<int, double> m;
+  for (int i = 0; i < 1000; ++i) {
+    m.insert({i * 3, i * 0.5});
+  }
+  m.save(path);
+
+  auto view = s21::map<int, double>::load_mapped(path);
+  ASSERT_EQ(view.size(), 1000u);
+  for (int i = 0; i < 1000; ++i) {
+    auto it = view.find(i * 3);
+    ASSERT_NE(it, view.end());
+    EXPECT_EQ(it->first, i * 3);
+    EXPECT_EQ(it->second, i * 0.5);
+    EXPECT_FALSE(view.contains(i * 3 + 1));
+  }
+  EXPECT_FALSE(view.contains(-1));
+  EXPECT_FALSE(view.contains(3000));
+  EXPECT_EQ(view.at(30), 5.0);
+  EXPECT_THROW(view.at(31), std::out_of_range);
+}
+
+TEST_F(MapSnapshotTest, MappedLowerBoundAcrossBlocks) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 100; ++i) {
+    m.insert({i * 10, i});
+  }
+  m.save(path);
+
+  auto view = s21::map<int, int>::load_mapped(path);
+  for (int key = -5; key <= 1000; ++key) {
+    auto it = view.lower_bound(key);
+    int expected = key <= 0 ? 0 : (key + 9) / 10 * 10;
+    if (expected > 990) {
+      EXPECT_EQ(it, view.end()) << key;
+    } else {
+      ASSERT_NE(it, view.end()) << key;
+      EXPECT_EQ(it->first, expected) << key;
+    }
+  }
+}
+
+TEST_F(MapSnapshotTest, MappedIteratesInOrder) {
+  s21::map<int, int> m = {{5, 50}, {1, 10}, {3, 30}};
+  m.save(path);
+
+  auto view = s21::map<int, int>::load_mapped(path);
+  std::vector<int> keys(view.keys().begin(), view.keys().end());
+  std::vector<int> values(view.values().begin(), view.values().end());
+  EXPECT_EQ(keys, (std::vector<int>{1, 3, 5}));
+  EXPECT_EQ(values, (std::vector<int>{10, 30, 50}));
+
+  auto it = view.end();
+  --it;
+  EXPECT_EQ((*it).first, 5);
+  int sum = 0;
+  for (auto [key, value] : view) {
+    sum += key + value;
+  }
+  EXPECT_EQ(sum, 99);
+}
+
+TEST_F(MapSnapshotTest, EmptyMapRoundTrips) {
+  s21::map<int, int> m;
+  m.save(path);
+
+  auto view = s21::map<int, int>::load_mapped(path);
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(view.begin(), view.end());
+  EXPECT_FALSE(view.contains(0));
+  EXPECT_TRUE((s21::map<int, int>::load(path).empty()));
+}
+
+TEST_F(MapSnapshotTest, MappedMapMoves) {
+  s21::map<int, int> m = {{1, 2}};
+  m.save(path);
+
+  auto view = s21::map<int, int>::load_mapped(path);
+  s21::mapped_map<int, int> other(std::move(view));
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(other.at(1), 2);
+  view = std::move(other);
+  EXPECT_EQ(view.at(1), 2);
+}
+
+TEST_F(MapSnapshotTest, LoadTriviallyCopyable) {
+  s21::map<std::uint64_t, int> m;
+  for (int i = 0; i < 500; ++i) {
+    m.insert({static_cast<std::uint64_t>(i) * 7919 % 1000, i});
+  }
+  m.save(path);
+
+  auto loaded = s21::map<std::uint64_t, int>::load(path);
+  EXPECT_EQ(loaded.size(), m.size());
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    EXPECT_EQ(loaded.at(it->first), it->second);
+  }
+  loaded.insert({5000, 1});
+  EXPECT_TRUE(loaded.contains(5000));
+}
+
+TEST_F(MapSnapshotTest, LoadStrings) {
+  s21::map<std::string, std::string> m;
+  for (int i = 0; i < 200; ++i) {
+    m.insert({"key" + std::to_string(i), std::string(i, 'x')});
+  }
+  m.save(path);
+
+  auto loaded = s21::map<std::string, std::string>::load(path);
+  ASSERT_EQ(loaded.size(), 200u);
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(loaded.at("key" + std::to_string(i)), std::string(i, 'x'));
+  }
+}
+
+TEST_F(MapSnapshotTest, SaveReplacesExistingFile) {
+  s21::map<int, int> first = {{1, 1}, {2, 2}};
+  s21::map<int, int> second = {{3, 3}};
+  first.save(path);
+  second.save(path);
+
+  auto view = s21::map<int, int>::load_mapped(path);
+  EXPECT_EQ(view.size(), 1u);
+  EXPECT_TRUE(view.contains(3));
+}
+
+TEST_F(MapSnapshotTest, RejectsMismatchedFiles) {
+  EXPECT_THROW((s21::map<int, int>::load_mapped(path)), std::system_error);
+
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not a snapshot";
+  }
+  EXPECT_THROW((s21::map<int, int>::load_mapped(path)), std::runtime_error);
+
+  s21::map<int, int> m = {{1, 1}};
+  m.save(path);
+  EXPECT_THROW((s21::map<std::uint64_t, int>::load_mapped(path)),
+               std::runtime_error);
+  EXPECT_THROW((s21::map<std::string, int>::load(path)), std::runtime_error);
+
+  s21::map<std::string, int> strings = {{"a", 1}, {"b", 2}};
+  strings.save(path);
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 4));
+  }
+  EXPECT_THROW((s21::map<std::string, int>::load(path)), std::runtime_error);
+}
+
+// A corrupt string length or element count is reported as a short file,
+// not attempted as an allocation.
+TEST_F(MapSnapshotTest, RejectsCorruptLengths) {
+  s21::map<std::string, int> strings = {{"a", 1}, {"b", 2}};
+  strings.save(path);
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  auto write_with = [&](std::size_t offset, std::uint64_t value) {
+    std::string corrupt = bytes;
+    std::memcpy(corrupt.data() + offset, &value, sizeof(value));
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+  };
+
+  write_with(sizeof(s21::snapshot::header), std::uint64_t{1} << 62);
+  EXPECT_THROW((s21::map<std::string, int>::load(path)), std::runtime_error);
+  write_with(offsetof(s21::snapshot::header, count), std::uint64_t{1} << 62);
+  EXPECT_THROW((s21::map<std::string, int>::load(path)), std::runtime_error);
+}
+
+// Every index size, so each shape of the Eytzinger tree's bottom level is
+// searched.
+TEST_F(MapSnapshotTest, MappedFindsKeysAtEverySize) {
+  s21::map<int, int> m;
+  for (int n = 1; n <= 40 * 16; ++n) {
+    m.insert({2 * n, n});
+    if (n % 7 != 0 && n % 16 != 0) {
+      continue;
+    }
+    m.save(path);
+    auto view = s21::map<int, int>::load_mapped(path);
+    for (int key = 1; key <= 2 * n + 1; ++key) {
+      auto it = view.lower_bound(key);
+      if (key > 2 * n) {
+        EXPECT_EQ(it, view.end()) << n << " " << key;
+      } else {
+        ASSERT_NE(it, view.end()) << n << " " << key;
+        EXPECT_EQ(it->first, (key + 1) / 2 * 2) << n << " " << key;
+      }
+    }
+  }
+}
+
+// Scrambled index keys give wrong answers but never lead a lookup outside
+// the mapped arrays.
+TEST_F(MapSnapshotTest, CorruptIndexStaysInBounds) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 1000; ++i) {
+    m.insert({i, i});
+  }
+  m.save(path);
+  std::string bytes;
+  {
+    std::ifstream in(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  s21::snapshot::header h;
+  std::memcpy(&h, bytes.data(), sizeof(h));
+  for (std::uint64_t k = 1; k <= h.index_count; ++k) {
+    int scrambled = static_cast<int>(k * 7919 % 2000) - 500;
+    std::memcpy(bytes.data() + h.index_keys_offset + k * sizeof(int),
+                &scrambled, sizeof(int));
+  }
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  auto view = s21::map<int, int>::load_mapped(path);
+  for (int key = -10; key < 1010; ++key) {
+    auto it = view.lower_bound(key);
+    EXPECT_LE(std::distance(view.begin(), it), 1000);
+    EXPECT_GE(std::distance(view.begin(), it), 0);
+    view.contains(key);
+  }
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <sys/mman.h>
+
+// A low threshold keeps the mapped blocks small: anything from 4 KiB up is
+// mapped.
+using SmallThreshold = s21::mmap_allocator<int, 4096>;
+
+TEST(MmapAllocatorTest, LargeBlocksAreHugePageAligned) {
+  SmallThreshold alloc;
+  int *small = alloc.allocate(16);
+  int *large = alloc.allocate(100000);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % SmallThreshold::huge_page,
+            0);
+  for (int i = 0; i < 100000; ++i) {
+    large[i] = i;
+  }
+  small[15] = 1;
+  EXPECT_EQ(large[99999], 99999);
+  alloc.deallocate(small, 16);
+  alloc.deallocate(large, 100000);
+}
+
+TEST(MmapAllocatorTest, ReallocateKeepsContents) {
+  SmallThreshold alloc;
+  int *p = alloc.allocate(100);
+  for (int i = 0; i < 100; ++i) {
+    p[i] = i;
+  }
+  // Heap to mapping, mapping to a larger mapping, then back to the heap.
+  p = alloc.reallocate(p, 100, 10000);
+  for (int i = 100; i < 10000; ++i) {
+    p[i] = i;
+  }
+  p = alloc.reallocate(p, 10000, 2000000);
+  EXPECT_EQ(p[9999], 9999);
+  p[1999999] = -1;
+  p = alloc.reallocate(p, 2000000, 50);
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(p[i], i);
+  }
+  alloc.deallocate(p, 50);
+}
+
+// A mapping placed right after the block stops it growing in place, so
+// reallocate has to move it and must keep it huge page aligned.
+TEST(MmapAllocatorTest, MovedBlockStaysHugePageAligned) {
+  SmallThreshold alloc;
+  constexpr std::size_t huge = SmallThreshold::huge_page;
+  constexpr std::size_t n = huge / sizeof(int);
+  int *p = alloc.allocate(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    p[i] = static_cast<int>(i);
+  }
+  char *end = reinterpret_cast<char *>(p) + huge;
+  void *blocker = ::mmap(end, 4096, PROT_READ,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1,
+                         0);
+  ASSERT_EQ(blocker, end);
+
+  int *grown = alloc.reallocate(p, n, 3 * n);
+  EXPECT_NE(grown, p);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(grown) % huge, 0);
+  EXPECT_EQ(grown[n - 1], static_cast<int>(n - 1));
+  grown[3 * n - 1] = 1;
+  alloc.deallocate(grown, 3 * n);
+  ::munmap(blocker, 4096);
+}
+
+TEST(MmapAllocatorTest, VectorGrowsThroughReallocate) {
+  s21::vector<int, SmallThreshold> v;
+  for (int i = 0; i < 1000000; ++i) {
+    v.push_back(i);
+  }
+  v.insert(v.begin() + 1, 3, -1);
+  v.emplace(v.begin(), v[999]);
+  ASSERT_EQ(v.size(), 1000004);
+  EXPECT_EQ(v[0], 996);
+  EXPECT_EQ(v[2], -1);
+  EXPECT_EQ(v[5], 1);
+  EXPECT_EQ(v[1000003], 999999);
+
+  v.reserve(5000000);
+  EXPECT_EQ(v[1000003], 999999);
+  for (int i = 0; i < 999000; ++i) {
+    v.pop_back();
+  }
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 1004);
+  EXPECT_EQ(v[1003], 999);
+}
+
+TEST(MmapAllocatorTest, NonRelocatableElementsStillCopy) {
+  s21::vector<std::string, s21::mmap_allocator<std::string, 4096>> v;
+  for (int i = 0; i < 2000; ++i) {
+    v.push_back(std::to_string(i));
+  }
+  v.insert(v.begin(), 2, v[1999]);
+  EXPECT_EQ(v[0], "1999");
+  EXPECT_EQ(v[2001], "1999");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
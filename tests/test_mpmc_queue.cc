@@ -0,0 +1,151 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(MpmcQueueTest, RoundsCapacityUp) {
+  s21::mpmc_queue<int> one(1);
+  EXPECT_EQ(one.capacity(), 2);
+  s21::mpmc_queue<int> queue(100);
+  EXPECT_EQ(queue.capacity(), 128);
+  EXPECT_THROW(s21::mpmc_queue<int>(0), std::invalid_argument);
+}
+
+TEST(MpmcQueueTest, FifoUntilFull) {
+  s21::mpmc_queue<int> queue(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+  EXPECT_EQ(queue.size_approx(), 4);
+
+  int out = -1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, i);
+  }
+  EXPECT_FALSE(queue.try_pop(out));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpmcQueueTest, ThrowingConstructorLeavesQueueUsable) {
+  s21::mpmc_queue<std::string> queue(2);
+  EXPECT_THROW(queue.try_emplace(static_cast<const char *>(nullptr)),
+               std::logic_error);
+  EXPECT_TRUE(queue.try_emplace(2, 'x'));
+  std::string out;
+  EXPECT_TRUE(queue.try_pop(out));
+  EXPECT_EQ(out, "xx");
+  EXPECT_FALSE(queue.try_pop(out));
+}
+
+TEST(MpmcQueueTest, BatchPushAndPop) {
+  s21::mpmc_queue<int> queue(8);
+  std::vector<int> input = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(queue.try_push_batch(input.begin(), input.end()), 8);
+  EXPECT_EQ(queue.try_push_batch(input.begin(), input.end()), 0);
+
+  int out[5] = {};
+  EXPECT_EQ(queue.try_pop_batch(out, 5), 5);
+  EXPECT_EQ(out[4], 4);
+  EXPECT_EQ(queue.try_push_batch(input.begin() + 8, input.end()), 2);
+
+  std::vector<int> rest(5);
+  EXPECT_EQ(queue.try_pop_batch(rest.begin(), 100), 5);
+  EXPECT_EQ(rest, std::vector<int>({5, 6, 7, 8, 9}));
+}
+
+TEST(MpmcQueueTest, DestroysLeftovers) {
+  auto tracked = std::make_shared<int>(0);
+  {
+    s21::mpmc_queue<std::shared_ptr<int>> queue(4);
+    queue.try_push(tracked);
+    queue.try_push(tracked);
+    EXPECT_EQ(tracked.use_count(), 3);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+// Several producers and consumers share a small queue. Every value must be
+// delivered exactly once, and each consumer must see any one producer's
+// values in increasing order. Run under ThreadSanitizer by `make tsan`.
+TEST(MpmcQueueStressTest, ExactlyOnceDelivery) {
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr long per_producer = 200000;
+  s21::mpmc_queue<long> queue(64);
+  std::vector<std::atomic<int>> seen(producers * per_producer);
+  std::atomic<long> delivered{0};
+  std::atomic<bool> ordered{true};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      long base = p * per_producer;
+      for (long i = 0; i < per_producer;) {
+        if (i % 2 == 0) {
+          long batch[5];
+          long n = per_producer - i < 5 ? per_producer - i : 5;
+          for (long j = 0; j < n; ++j) {
+            batch[j] = base + i + j;
+          }
+          long pushed =
+              static_cast<long>(queue.try_push_batch(batch, batch + n));
+          if (pushed == 0) {
+            std::this_thread::yield();
+          }
+          i += pushed;
+        } else if (queue.try_push(base + i)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      std::vector<long> last(producers, -1);
+      long buffer[8];
+      while (delivered.load(std::memory_order_relaxed) <
+             producers * per_producer) {
+        size_t n = queue.try_pop_batch(buffer, c % 2 ? 8 : 1);
+        if (n == 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        for (size_t j = 0; j < n; ++j) {
+          long value = buffer[j];
+          seen[value].fetch_add(1, std::memory_order_relaxed);
+          long producer = value / per_producer;
+          if (value <= last[producer]) {
+            ordered = false;
+          }
+          last[producer] = value;
+        }
+        delivered.fetch_add(static_cast<long>(n), std::memory_order_relaxed);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(delivered.load(), producers * per_producer);
+  long wrong = 0;
+  for (auto &count : seen) {
+    wrong += count.load() != 1;
+  }
+  EXPECT_EQ(wrong, 0);
+  EXPECT_TRUE(queue.empty());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,231 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Large enough to span many chunks of ints (16K elements each).
+constexpr int kSize = 300007;
+
+static s21::vector<int> RandomInts(int n, std::uint32_t seed = 7) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-1000000, 1000000);
+  s21::vector<int> v;
+  v.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    v.push_back(dist(gen));
+  }
+  return v;
+}
+
+static std::vector<int> ToStd(const s21::vector<int> &v) {
+  return std::vector<int>(v.begin(), v.end());
+}
+
+// Every test runs on pools of one thread (all on the caller), two and
+// four threads.
+class ParallelTest : public ::testing::TestWithParam<int> {
+protected:
+  s21::parallel::thread_pool pool{static_cast<size_t>(GetParam())};
+};
+
+INSTANTIATE_TEST_SUITE_P(Threads, ParallelTest, ::testing::Values(1, 2, 4));
+
+TEST_P(ParallelTest, InvokeRunsBoth) {
+  EXPECT_EQ(pool.concurrency(), static_cast<size_t>(GetParam()));
+  int a = 0;
+  int b = 0;
+  pool.invoke([&] { a = 1; }, [&] { b = 2; });
+  EXPECT_EQ(a, 1);
+  EXPECT_EQ(b, 2);
+}
+
+static long Fib(s21::parallel::thread_pool &pool, int n) {
+  if (n < 2) {
+    return n;
+  }
+  long x = 0;
+  long y = 0;
+  pool.invoke([&] { x = Fib(pool, n - 1); }, [&] { y = Fib(pool, n - 2); });
+  return x + y;
+}
+
+TEST_P(ParallelTest, NestedInvoke) { EXPECT_EQ(Fib(pool, 18), 2584); }
+
+TEST_P(ParallelTest, InvokePropagatesExceptions) {
+  std::atomic<int> finished{0};
+  EXPECT_THROW(pool.invoke([] { throw std::runtime_error("a"); },
+                           [&] { ++finished; }),
+               std::runtime_error);
+  EXPECT_EQ(finished.load(), 1);
+  EXPECT_THROW(pool.invoke([&] { ++finished; },
+                           [] { throw std::logic_error("b"); }),
+               std::logic_error);
+  EXPECT_EQ(finished.load(), 2);
+}
+
+TEST_P(ParallelTest, ForEach) {
+  s21::vector<int> v(kSize);
+  s21::parallel::for_each(pool, v.begin(), v.end(), [](int &x) { x += 3; });
+  EXPECT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 3; }));
+}
+
+TEST_P(ParallelTest, Transform) {
+  s21::vector<int> in = RandomInts(kSize);
+  s21::vector<long> out(kSize);
+  auto end = s21::parallel::transform(pool, in.begin(), in.end(), out.begin(),
+                                      [](int x) { return 2L * x + 1; });
+  EXPECT_EQ(end, out.end());
+  for (int i = 0; i < kSize; ++i) {
+    ASSERT_EQ(out[i], 2L * in[i] + 1);
+  }
+}
+
+TEST_P(ParallelTest, Reduce) {
+  s21::vector<int> in = RandomInts(kSize);
+  long expected = std::accumulate(in.begin(), in.end(), 5L);
+  EXPECT_EQ(s21::parallel::reduce(pool, in.begin(), in.end(), 5L), expected);
+  EXPECT_EQ(s21::parallel::reduce(pool, in.begin(), in.begin()), 0);
+  EXPECT_EQ(s21::parallel::reduce(pool, in.begin(), in.end(), 0L,
+                                  [](long a, long b) { return std::max(a, b); }),
+            *std::max_element(in.begin(), in.end()));
+}
+
+// Chunking does not depend on the thread count, so a floating-point sum is
+// the same on every pool.
+TEST_P(ParallelTest, ReduceIsDeterministic) {
+  s21::vector<double> in;
+  for (int i = 0; i < kSize; ++i) {
+    in.push_back(1.0 / (i + 1));
+  }
+  s21::parallel::thread_pool single(1);
+  double expected = s21::parallel::reduce(single, in.begin(), in.end(), 0.0);
+  for (int run = 0; run < 3; ++run) {
+    EXPECT_EQ(s21::parallel::reduce(pool, in.begin(), in.end(), 0.0), expected);
+  }
+}
+
+// String concatenation is associative but not commutative.
+TEST_P(ParallelTest, ReduceKeepsOrder) {
+  s21::vector<std::string> in;
+  std::string expected;
+  for (int i = 0; i < 20000; ++i) {
+    in.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+    expected += in.back();
+  }
+  EXPECT_EQ(s21::parallel::reduce(pool, in.begin(), in.end(), std::string()),
+            expected);
+}
+
+TEST_P(ParallelTest, InclusiveScan) {
+  s21::vector<int> in = RandomInts(kSize);
+  std::vector<long long> expected(kSize);
+  std::inclusive_scan(in.begin(), in.end(), expected.begin(), std::plus<>(),
+                      0LL);
+  s21::vector<long long> wide(kSize);
+  std::copy(in.begin(), in.end(), wide.begin());
+  auto end = s21::parallel::inclusive_scan(pool, wide.begin(), wide.end(),
+                                           wide.begin());
+  EXPECT_EQ(end, wide.end());
+  EXPECT_TRUE(std::equal(wide.begin(), wide.end(), expected.begin()));
+
+  s21::vector<int> out(kSize);
+  s21::parallel::inclusive_scan(pool, in.begin(), in.end(), out.begin(),
+                                [](int a, int b) { return std::max(a, b); });
+  int running = in[0];
+  for (int i = 0; i < kSize; ++i) {
+    running = std::max(running, in[i]);
+    ASSERT_EQ(out[i], running);
+  }
+}
+
+// The chunk totals are combined the same way on every pool, so a
+// floating-point scan is the same with one thread as with four.
+TEST_P(ParallelTest, InclusiveScanIsDeterministic) {
+  s21::vector<double> in;
+  for (int i = 0; i < kSize; ++i) {
+    in.push_back(1.0 / (i + 1));
+  }
+  s21::parallel::thread_pool single(1);
+  s21::vector<double> expected(kSize);
+  s21::parallel::inclusive_scan(single, in.begin(), in.end(),
+                                expected.begin());
+  s21::vector<double> out(kSize);
+  for (int run = 0; run < 3; ++run) {
+    s21::parallel::inclusive_scan(pool, in.begin(), in.end(), out.begin());
+    ASSERT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+  }
+}
+
+TEST_P(ParallelTest, CopyIfIsStable) {
+  s21::vector<int> in = RandomInts(kSize);
+  auto even = [](int x) { return x % 2 == 0; };
+  std::vector<int> expected;
+  std::copy_if(in.begin(), in.end(), std::back_inserter(expected), even);
+
+  s21::vector<int> out(kSize);
+  auto end = s21::parallel::copy_if(pool, in.begin(), in.end(), out.begin(),
+                                    even);
+  ASSERT_EQ(static_cast<size_t>(end - out.begin()), expected.size());
+  EXPECT_TRUE(std::equal(out.begin(), end, expected.begin()));
+}
+
+TEST_P(ParallelTest, Sort) {
+  s21::vector<int> v = RandomInts(kSize * 2);
+  std::vector<int> expected = ToStd(v);
+  std::sort(expected.begin(), expected.end());
+  s21::parallel::sort(pool, v.begin(), v.end());
+  EXPECT_EQ(ToStd(v), expected);
+
+  s21::parallel::sort(pool, v.begin(), v.end(), std::greater<>());
+  std::reverse(expected.begin(), expected.end());
+  EXPECT_EQ(ToStd(v), expected);
+
+  s21::vector<int> few = {3, 1, 2};
+  s21::parallel::sort(pool, few.begin(), few.end());
+  EXPECT_EQ(ToStd(few), (std::vector<int>{1, 2, 3}));
+  s21::parallel::sort(pool, few.begin(), few.begin());
+}
+
+TEST_P(ParallelTest, SortStrings) {
+  s21::vector<int> keys = RandomInts(40000, 11);
+  s21::vector<std::string> v;
+  for (int key : keys) {
+    v.push_back(std::to_string(key) + std::string(20, 'x'));
+  }
+  std::vector<std::string> expected(v.begin(), v.end());
+  std::sort(expected.begin(), expected.end());
+  s21::parallel::sort(pool, v.begin(), v.end());
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin()));
+}
+
+TEST_P(ParallelTest, ExceptionsReachTheCaller) {
+  s21::vector<int> v(kSize);
+  EXPECT_THROW(s21::parallel::for_each(pool, v.begin(), v.end(),
+                                       [](int &x) {
+                                         if (x == 0) {
+                                           throw std::runtime_error("x");
+                                         }
+                                       }),
+               std::runtime_error);
+}
+
+TEST(ParallelDefaultPool, RunsAlgorithms) {
+  s21::vector<int> v = RandomInts(kSize);
+  s21::parallel::sort(v.begin(), v.end());
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+  EXPECT_GE(s21::parallel::default_pool().concurrency(), 1u);
+  EXPECT_EQ(s21::parallel::reduce(v.begin(), v.end(), 0L),
+            std::accumulate(v.begin(), v.end(), 0L));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
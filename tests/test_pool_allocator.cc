@@ -0,0 +1,164 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+struct alignas(32) Wide {
+  char bytes[48];
+};
+
+TEST(PoolAllocatorTest, ReusesFreedBlocks) {
+  s21::pool_allocator<long> alloc;
+  long *a = alloc.allocate(1);
+  long *b = alloc.allocate(1);
+  EXPECT_NE(a, b);
+
+  alloc.deallocate(a, 1);
+  EXPECT_EQ(alloc.allocate(1), a);
+  alloc.deallocate(b, 1);
+  alloc.deallocate(a, 1);
+}
+
+TEST(PoolAllocatorTest, BlocksAreDistinctAndAligned) {
+  s21::pool_allocator<Wide> alloc;
+  std::set<Wide *> seen;
+  for (int i = 0; i < 1000; ++i) {
+    Wide *p = alloc.allocate(1);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(Wide), 0u);
+    EXPECT_TRUE(seen.insert(p).second);
+  }
+  alloc.release();
+}
+
+TEST(PoolAllocatorTest, ArrayAllocationsBypassPool) {
+  s21::pool_allocator<int> alloc;
+  int *p = alloc.allocate(16);
+  for (int i = 0; i < 16; ++i)
+    p[i] = i;
+  EXPECT_EQ(p[15], 15);
+  alloc.deallocate(p, 16);
+}
+
+TEST(PoolAllocatorTest, CopiesAndRebindsShare) {
+  s21::pool_allocator<int> a;
+  int *p = a.allocate(1);
+  s21::pool_allocator<int> b(a);
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a == a.select_on_container_copy_construction());
+
+  s21::pool_allocator<double> c(a);
+  s21::pool_allocator<int> d(c);
+  EXPECT_TRUE(c == a);
+  EXPECT_TRUE(a == d);
+  d.deallocate(p, 1);
+  EXPECT_EQ(a.allocate(1), p);
+
+  double *q = c.allocate(1);
+  s21::pool_allocator<double>(d).deallocate(q, 1);
+  EXPECT_EQ(c.allocate(1), q);
+  c.deallocate(q, 1);
+  a.deallocate(p, 1);
+}
+
+TEST(PoolAllocatorTest, AdoptTakesEveryBlockSize) {
+  s21::pool_allocator<long> a;
+  s21::pool_allocator<long> b;
+  b.allocate(1);
+  s21::pool_allocator<Wide> b_wide(b);
+  Wide *wide = b_wide.allocate(1);
+  b_wide = s21::pool_allocator<Wide>();
+
+  EXPECT_TRUE(a.adopt(b));
+  s21::pool_allocator<Wide> a_wide(a);
+  a_wide.deallocate(wide, 1);
+  EXPECT_EQ(a_wide.allocate(1), wide);
+}
+
+TEST(PoolAllocatorTest, MapChurnWithStrings) {
+  s21::map<int, std::string> map;
+  for (int round = 0; round < 4; ++round) {
+    for (int i = 0; i < 2000; ++i)
+      map.insert({i, std::string(32, 'a' + round)});
+    for (int i = 0; i < 2000; i += 2)
+      map.erase(map.begin());
+    map.clear();
+    EXPECT_TRUE(map.empty());
+  }
+  map.insert({1, "one"});
+  EXPECT_EQ(map.at(1), "one");
+}
+
+TEST(PoolAllocatorTest, MapCopyMoveAndSwap) {
+  s21::map<int, std::string> a = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::map<int, std::string> b(a);
+  a.clear();
+  EXPECT_EQ(b.size(), 3);
+  EXPECT_EQ(b.at(2), "b");
+
+  s21::map<int, std::string> c(std::move(b));
+  c.insert({4, "d"});
+  EXPECT_EQ(c.size(), 4);
+
+  a = c;
+  c.clear();
+  EXPECT_EQ(a.at(4), "d");
+
+  a.swap(c);
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(c.size(), 4);
+
+  a = std::move(c);
+  EXPECT_EQ(a.at(1), "a");
+}
+
+TEST(PoolAllocatorTest, StandardAllocatorMap) {
+  s21::map<int, std::string, std::allocator<std::pair<const int, std::string>>>
+      map;
+  for (int i = 0; i < 100; ++i)
+    map.insert({i, std::to_string(i)});
+  map.erase(map.begin());
+  EXPECT_EQ(map.size(), 99);
+  EXPECT_EQ(map.at(50), "50");
+
+  auto copy = map;
+  map.clear();
+  EXPECT_EQ(copy.at(99), "99");
+}
+
+#ifndef NDEBUG
+// A moved-from allocator has no pool; freeing a block through it is a bug
+// that is caught instead of dereferencing the missing pool.
+TEST(PoolAllocatorDeathTest, DeallocateWithoutPoolAsserts) {
+  s21::pool_allocator<long> a;
+  long *p = a.allocate(1);
+  s21::pool_allocator<long> b(std::move(a));
+  EXPECT_DEATH(a.deallocate(p, 1), "without a pool");
+  b.deallocate(p, 1);
+}
+#endif
+
+TEST(PoolAllocatorTest, AdoptSharesBlocks) {
+  s21::pool_allocator<long> a;
+  s21::pool_allocator<long> b;
+  long *from_b = b.allocate(1);
+  a.allocate(1);
+  EXPECT_FALSE(a == b);
+
+  EXPECT_TRUE(a.adopt(b));
+  EXPECT_TRUE(a == b);
+  EXPECT_FALSE(a.owns_pool());
+  a.deallocate(from_b, 1);
+  EXPECT_EQ(b.allocate(1), from_b);
+
+  s21::pool_allocator<long> c;
+  c.allocate(1);
+  s21::pool_allocator<long> c_copy(c);
+  s21::pool_allocator<long> d;
+  EXPECT_FALSE(d.adopt(c));
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
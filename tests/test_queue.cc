@@ -1,6 +1,8 @@
 #include "../include/s21/s21_containers.h"
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+
 class Person {
 public:
     std::string name;
@@ -144,6 +146,34 @@ TEST_F(PersonQueueTest, NestedQueues) {
     EXPECT_EQ(queue_of_queues.front().front().name, "Alice");
 }
 
+TEST(QueueAllocator, PmrQueueUsesResource) {
+    alignas(std::max_align_t) unsigned char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(
+        buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    std::pmr::polymorphic_allocator<int> alloc(&arena);
+    s21::pmr::queue<int> queue(alloc);
+    for (int i = 0; i < 100; ++i) {
+        queue.push(i);
+    }
+    queue.pop();
+    EXPECT_EQ(queue.front(), 1);
+    EXPECT_EQ(queue.back(), 99);
+
+    s21::pmr::queue<int> moved(std::move(queue), alloc);
+    EXPECT_EQ(moved.size(), 99);
+}
+
+TEST(QueueAllocator, ForwardsAllocatorToVector) {
+    std::pmr::monotonic_buffer_resource arena;
+    using Queue = s21::queue<int, s21::pmr::vector<int>>;
+    std::pmr::polymorphic_allocator<int> alloc(&arena);
+    Queue queue({1, 2, 3}, alloc);
+    Queue copy(queue, alloc);
+    copy.pop();
+    EXPECT_EQ(queue.front(), 1);
+    EXPECT_EQ(copy.front(), 2);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
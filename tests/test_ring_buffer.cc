@@ -0,0 +1,130 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+TEST(RingBufferTest, StartsEmpty) {
+  s21::ring_buffer<int> rb;
+  EXPECT_TRUE(rb.empty());
+  EXPECT_EQ(rb.size(), 0);
+  EXPECT_EQ(rb.capacity(), 0);
+  EXPECT_THROW(rb.front(), std::out_of_range);
+  EXPECT_THROW(rb.back(), std::out_of_range);
+  EXPECT_THROW(rb.pop_front(), std::runtime_error);
+}
+
+TEST(RingBufferTest, FifoOrder) {
+  s21::ring_buffer<int> rb = {1, 2, 3};
+  rb.push_back(4);
+
+  EXPECT_EQ(rb.size(), 4);
+  EXPECT_EQ(rb.front(), 1);
+  EXPECT_EQ(rb.back(), 4);
+
+  rb.pop_front();
+  EXPECT_EQ(rb.front(), 2);
+  EXPECT_EQ(rb[2], 4);
+}
+
+TEST(RingBufferTest, CapacityIsPowerOfTwo) {
+  s21::ring_buffer<int> rb;
+  rb.reserve(5);
+  EXPECT_EQ(rb.capacity(), 8);
+  for (int i = 0; i < 9; ++i)
+    rb.push_back(i);
+  EXPECT_EQ(rb.capacity(), 16);
+}
+
+TEST(RingBufferTest, GrowWhileWrapped) {
+  s21::ring_buffer<std::string> rb;
+  rb.reserve(4);
+  rb.push_back("a");
+  rb.push_back("b");
+  rb.push_back("c");
+  rb.pop_front();
+  rb.pop_front();
+  rb.push_back("d");
+  rb.push_back("e");
+  rb.push_back("f");
+  EXPECT_EQ(rb.capacity(), 4);
+
+  rb.push_back("g");
+  EXPECT_EQ(rb.capacity(), 8);
+  const char *expected[] = {"c", "d", "e", "f", "g"};
+  ASSERT_EQ(rb.size(), 5);
+  for (size_t i = 0; i < rb.size(); ++i) {
+    EXPECT_EQ(rb[i], expected[i]);
+  }
+}
+
+TEST(RingBufferTest, GrowthMovesElements) {
+  s21::ring_buffer<std::unique_ptr<int>> rb;
+  for (int i = 0; i < 100; ++i) {
+    rb.push_back(std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(*rb.front(), i);
+    rb.pop_front();
+  }
+  EXPECT_TRUE(rb.empty());
+}
+
+TEST(RingBufferTest, PushBackOwnElement) {
+  s21::ring_buffer<std::string> rb = {"first"};
+  EXPECT_EQ(rb.capacity(), 1);
+  rb.push_back(rb.front());
+  EXPECT_EQ(rb.back(), "first");
+  EXPECT_EQ(rb.size(), 2);
+}
+
+TEST(RingBufferTest, CopyAndMove) {
+  s21::ring_buffer<std::string> rb;
+  rb.reserve(2);
+  rb.push_back("x");
+  rb.push_back("y");
+  rb.pop_front();
+  rb.push_back("z");
+
+  s21::ring_buffer<std::string> copy(rb);
+  EXPECT_EQ(copy.size(), 2);
+  EXPECT_EQ(copy.front(), "y");
+  EXPECT_EQ(copy.back(), "z");
+
+  s21::ring_buffer<std::string> moved(std::move(rb));
+  EXPECT_TRUE(rb.empty());
+  EXPECT_EQ(moved.front(), "y");
+
+  rb = copy;
+  EXPECT_EQ(rb.back(), "z");
+  copy = std::move(moved);
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ(copy.size(), 2);
+}
+
+TEST(RingBufferTest, QueueDrainsLargeBacklog) {
+  s21::queue<int> queue;
+  const int N = 1000000;
+  for (int i = 0; i < N; ++i) {
+    queue.push(i);
+  }
+  for (int i = 0; i < N; ++i) {
+    ASSERT_EQ(queue.front(), i);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(RingBufferTest, QueueOverVectorStillWorks) {
+  s21::queue<int, s21::vector<int>> queue;
+  queue.push(1);
+  queue.push(2);
+  queue.pop();
+  EXPECT_EQ(queue.front(), 2);
+  EXPECT_EQ(queue.size(), 1);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
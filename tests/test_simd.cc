@@ -0,0 +1,234 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// Every kernel is checked against the scalar loop at each level this CPU
+// supports, on lengths around the vector and unroll widths so that every
+// tail is covered.
+static std::vector<s21::simd::level> Levels() {
+  std::vector<s21::simd::level> levels;
+  for (auto l : {s21::simd::level::scalar, s21::simd::level::sse2,
+                 s21::simd::level::avx2, s21::simd::level::avx512}) {
+    if (l <= s21::simd::detected_level()) {
+      levels.push_back(l);
+    }
+  }
+  return levels;
+}
+
+static std::vector<size_t> Lengths() {
+  std::vector<size_t> lengths;
+  for (size_t n = 0; n <= 300; ++n) {
+    lengths.push_back(n);
+  }
+  lengths.push_back(1000);
+  lengths.push_back(4099);
+  return lengths;
+}
+
+// Restores the detected level after each test.
+template <typename T> class SimdKernelTest : public ::testing::Test {
+protected:
+  void TearDown() override {
+    s21::simd::set_level(s21::simd::detected_level());
+  }
+
+  // Values from a small range so that every value repeats.
+  static std::vector<T> Random(size_t n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::vector<T> v(n);
+    for (T &x : v) {
+      x = static_cast<T>(gen() % 50);
+    }
+    return v;
+  }
+};
+
+using KernelTypes =
+    ::testing::Types<std::int8_t, std::uint8_t, std::int16_t, std::uint16_t,
+                     std::int32_t, std::uint32_t, std::int64_t, std::uint64_t,
+                     float, double>;
+TYPED_TEST_SUITE(SimdKernelTest, KernelTypes);
+
+TYPED_TEST(SimdKernelTest, Find) {
+  for (auto level : Levels()) {
+    s21::simd::set_level(level);
+    for (size_t n : Lengths()) {
+      auto v = this->Random(n, static_cast<unsigned>(n));
+      for (TypeParam value : {TypeParam(0), TypeParam(7), TypeParam(49),
+                              TypeParam(50)}) {
+        size_t expected = static_cast<size_t>(
+            std::find(v.begin(), v.end(), value) - v.begin());
+        ASSERT_EQ(s21::simd::find(v.data(), n, value), expected)
+            << "n=" << n << " level=" << static_cast<int>(level);
+      }
+      // A match in the last position only.
+      if (n > 0) {
+        std::vector<TypeParam> zeros(n, TypeParam(0));
+        zeros.back() = TypeParam(1);
+        ASSERT_EQ(s21::simd::find(zeros.data(), n, TypeParam(1)), n - 1);
+      }
+    }
+  }
+}
+
+TYPED_TEST(SimdKernelTest, Count) {
+  for (auto level : Levels()) {
+    s21::simd::set_level(level);
+    for (size_t n : Lengths()) {
+      auto v = this->Random(n, static_cast<unsigned>(n) + 1);
+      for (TypeParam value : {TypeParam(0), TypeParam(13)}) {
+        ASSERT_EQ(s21::simd::count(v.data(), n, value),
+                  static_cast<size_t>(std::count(v.begin(), v.end(), value)))
+            << "n=" << n << " level=" << static_cast<int>(level);
+      }
+    }
+  }
+}
+
+// More matches than an 8-bit lane counter can hold.
+TYPED_TEST(SimdKernelTest, CountManyMatches) {
+  std::vector<TypeParam> v(200003, TypeParam(3));
+  for (auto level : Levels()) {
+    s21::simd::set_level(level);
+    EXPECT_EQ(s21::simd::count(v.data(), v.size(), TypeParam(3)), v.size());
+  }
+}
+
+TYPED_TEST(SimdKernelTest, Minmax) {
+  for (auto level : Levels()) {
+    s21::simd::set_level(level);
+    for (size_t n : Lengths()) {
+      if (n == 0) {
+        continue;
+      }
+      auto v = this->Random(n, static_cast<unsigned>(n) + 2);
+      v[n / 3] = std::numeric_limits<TypeParam>::lowest();
+      v[n - 1] = std::numeric_limits<TypeParam>::max();
+      auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+      auto result = s21::simd::minmax(v.data(), n);
+      ASSERT_EQ(result.first, *lo) << "n=" << n;
+      ASSERT_EQ(result.second, *hi) << "n=" << n;
+    }
+  }
+}
+
+TYPED_TEST(SimdKernelTest, Mismatch) {
+  for (auto level : Levels()) {
+    s21::simd::set_level(level);
+    for (size_t n : Lengths()) {
+      auto a = this->Random(n, 5);
+      auto b = a;
+      ASSERT_EQ(s21::simd::mismatch(a.data(), b.data(), n), n);
+      for (size_t at : {size_t{0}, n / 2, n - 1}) {
+        if (at >= n) {
+          continue;
+        }
+        b = a;
+        b[at] = static_cast<TypeParam>(b[at] + 1);
+        ASSERT_EQ(s21::simd::mismatch(a.data(), b.data(), n), at)
+            << "n=" << n << " at=" << at;
+      }
+    }
+  }
+}
+
+TEST(SimdFloat, NanAndSignedZero) {
+  float nan = std::numeric_limits<float>::quiet_NaN();
+  std::vector<float> a(100, 1.0f);
+  a[40] = nan;
+  a[70] = -0.0f;
+  for (auto level : Levels()) {
+    s21::simd::set_level(level);
+    EXPECT_EQ(s21::simd::find(a.data(), a.size(), nan), a.size());
+    EXPECT_EQ(s21::simd::find(a.data(), a.size(), 0.0f), 70u);
+    EXPECT_EQ(s21::simd::count(a.data(), a.size(), 1.0f), 98u);
+    // A NaN never equals itself.
+    EXPECT_EQ(s21::simd::mismatch(a.data(), a.data(), a.size()), 40u);
+  }
+  s21::simd::set_level(s21::simd::detected_level());
+}
+
+TEST(SimdLevel, SetLevelIsClamped) {
+  s21::simd::set_level(s21::simd::level::avx512);
+  EXPECT_EQ(s21::simd::active_level(), s21::simd::detected_level());
+  s21::simd::set_level(s21::simd::level::scalar);
+  EXPECT_EQ(s21::simd::active_level(), s21::simd::level::scalar);
+  s21::simd::set_level(s21::simd::detected_level());
+}
+
+TEST(VectorSearch, FindCountContains) {
+  s21::vector<int> v = {5, 3, 8, 3, 1};
+  EXPECT_EQ(v.find(3), v.begin() + 1);
+  EXPECT_EQ(v.find(4), v.end());
+  EXPECT_EQ(v.count(3), 2u);
+  EXPECT_TRUE(v.contains(8));
+  EXPECT_FALSE(v.contains(9));
+  EXPECT_EQ(v.minmax(), std::make_pair(1, 8));
+
+  s21::vector<std::string> words = {"b", "a", "c", "a"};
+  EXPECT_EQ(words.find("c"), words.begin() + 2);
+  EXPECT_EQ(words.count("a"), 2u);
+  EXPECT_EQ(words.minmax(), std::make_pair(std::string("a"), std::string("c")));
+
+  s21::vector<int> empty;
+  EXPECT_EQ(empty.find(1), empty.end());
+  EXPECT_THROW(empty.minmax(), std::out_of_range);
+}
+
+TEST(VectorCompare, Equality) {
+  s21::vector<std::uint8_t> a;
+  s21::vector<std::uint8_t> b;
+  a.assign(1000, 7);
+  b.assign(1000, 7);
+  EXPECT_TRUE(a == b);
+  b[999] = 8;
+  EXPECT_TRUE(a != b);
+  b.pop_back();
+  EXPECT_FALSE(a == b);
+
+  s21::vector<float> f = {1.0f, std::numeric_limits<float>::quiet_NaN()};
+  EXPECT_FALSE(f == f);
+  s21::vector<float> zeros = {0.0f};
+  s21::vector<float> negative_zeros = {-0.0f};
+  EXPECT_TRUE(zeros == negative_zeros);
+
+  s21::vector<std::string> s = {"x", "y"};
+  EXPECT_TRUE(s == (s21::vector<std::string>{"x", "y"}));
+}
+
+TEST(VectorCompare, ThreeWay) {
+  s21::vector<int> a = {1, 2, 3};
+  EXPECT_EQ(a <=> (s21::vector<int>{1, 2, 3}), std::strong_ordering::equal);
+  EXPECT_TRUE(a < (s21::vector<int>{1, 2, 4}));
+  EXPECT_TRUE(a > (s21::vector<int>{1, 2}));
+  EXPECT_TRUE(a < (s21::vector<int>{1, 2, 3, 0}));
+  EXPECT_TRUE(a > (s21::vector<int>{0, 9, 9, 9}));
+
+  s21::vector<float> f = {1.0f, std::numeric_limits<float>::quiet_NaN()};
+  s21::vector<float> g = {1.0f, 2.0f};
+  EXPECT_EQ(f <=> g, std::partial_ordering::unordered);
+  EXPECT_TRUE(g < (s21::vector<float>{1.0f, 2.0f, 0.0f}));
+
+  s21::vector<std::string> s = {"a", "b"};
+  EXPECT_TRUE(s < (s21::vector<std::string>{"a", "c"}));
+
+  // Differences far into a long vector, past the vector loop.
+  s21::vector<std::int64_t> big;
+  big.assign(100000, 1);
+  s21::vector<std::int64_t> other = big;
+  other[99990] = 0;
+  EXPECT_TRUE(big > other);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,205 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Counts heap allocations made through it in a shared counter.
+template <typename T> struct TallyAllocator {
+  using value_type = T;
+
+  std::shared_ptr<int> count;
+
+  explicit TallyAllocator(std::shared_ptr<int> counter)
+      : count(std::move(counter)) {}
+  template <typename U>
+  TallyAllocator(const TallyAllocator<U> &other) : count(other.count) {}
+
+  T *allocate(size_t n) {
+    ++*count;
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T *p, size_t) noexcept { ::operator delete(p); }
+  bool operator==(const TallyAllocator &other) const {
+    return count == other.count;
+  }
+};
+
+TEST(SmallVectorTest, NoAllocationUpToInlineCapacity) {
+  auto count = std::make_shared<int>(0);
+  s21::small_vector<int, 4, TallyAllocator<int>> v{TallyAllocator<int>(count)};
+  EXPECT_EQ(v.capacity(), 4);
+  for (int i = 0; i < 4; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(*count, 0);
+
+  v.push_back(4);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(*count, 1);
+  EXPECT_EQ(v.capacity(), 8);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(v[i], i);
+  }
+
+  v.pop_back();
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.back(), 3);
+}
+
+TEST(SmallVectorTest, InsertAndEraseAcrossSpill) {
+  s21::small_vector<std::string, 2> v = {"a", "c"};
+  v.insert(v.begin() + 1, "b");
+  EXPECT_FALSE(v.is_inline());
+  v.emplace(v.begin(), 2, 'z');
+  ASSERT_EQ(v.size(), 4);
+  EXPECT_EQ(v[0], "zz");
+  EXPECT_EQ(v[2], "b");
+  v.erase(v.begin());
+  EXPECT_EQ(v.front(), "a");
+  EXPECT_EQ(v.back(), "c");
+  EXPECT_THROW(v.at(3), std::out_of_range);
+  EXPECT_THROW(v.insert(v.end() + 1, "x"), std::out_of_range);
+}
+
+TEST(SmallVectorTest, PushOwnElementWhileSpilling) {
+  s21::small_vector<std::string, 2> v = {"first", "second"};
+  v.push_back(v[0]);
+  EXPECT_EQ(v[2], "first");
+}
+
+TEST(SmallVectorTest, CopyAndMoveInlineAndHeap) {
+  s21::small_vector<std::string, 3> small = {"x", "y"};
+  s21::small_vector<std::string, 3> big = {"1", "2", "3", "4"};
+
+  auto small_copy = small;
+  auto big_copy = big;
+  EXPECT_TRUE(small_copy.is_inline());
+  EXPECT_EQ(big_copy[3], "4");
+
+  const std::string *heap = big.data();
+  s21::small_vector<std::string, 3> moved_big(std::move(big));
+  EXPECT_EQ(moved_big.data(), heap);
+  EXPECT_TRUE(big.empty());
+  EXPECT_TRUE(big.is_inline());
+
+  s21::small_vector<std::string, 3> moved_small(std::move(small));
+  EXPECT_EQ(moved_small[1], "y");
+  EXPECT_TRUE(small.empty());
+
+  moved_small = std::move(moved_big);
+  EXPECT_EQ(moved_small.data(), heap);
+  moved_big = big_copy;
+  EXPECT_EQ(moved_big.size(), 4);
+  moved_big = small_copy;
+  EXPECT_EQ(moved_big.size(), 2);
+  EXPECT_EQ(moved_big[0], "x");
+}
+
+TEST(SmallVectorTest, SwapMixesInlineAndHeap) {
+  s21::small_vector<int, 2> a = {1};
+  s21::small_vector<int, 2> b = {4, 5, 6};
+  a.swap(b);
+  ASSERT_EQ(a.size(), 3);
+  ASSERT_EQ(b.size(), 1);
+  EXPECT_EQ(a[2], 6);
+  EXPECT_EQ(b[0], 1);
+  EXPECT_TRUE(b.is_inline());
+}
+
+TEST(SmallVectorTest, PmrSpillsIntoResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::small_vector<std::pmr::string, 2> v(&arena);
+  v.emplace_back("one");
+  v.emplace_back("two");
+  v.emplace_back("a string long enough to need its own heap block");
+  EXPECT_EQ(v[2].get_allocator().resource(), &arena);
+  EXPECT_EQ(v.get_allocator().resource(), &arena);
+}
+
+TEST(SmallVectorTest, SharesVectorInterfaceAndGrowth) {
+  s21::small_vector<int, 4, std::allocator<int>, s21::growth::one_and_half> v;
+  v.insert(v.end(), 3, 7);
+  EXPECT_TRUE(v.is_inline());
+  int more[] = {1, 9, 4};
+  v.append_range(more);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 6);
+  EXPECT_EQ(v.count(7), 3);
+  EXPECT_EQ(v.find(9) - v.begin(), 4);
+  EXPECT_EQ(v.minmax(), std::make_pair(1, 9));
+
+  v.assign({5, 6});
+  ASSERT_EQ(v.size(), 2);
+  EXPECT_EQ(v[1], 6);
+  v.shrink_to_fit();
+  EXPECT_TRUE(v.is_inline());
+
+  v.resize_and_overwrite(3, [](int *data, size_t n) {
+    data[2] = 8;
+    return n;
+  });
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.back(), 8);
+  EXPECT_TRUE(v == (s21::small_vector<int, 4, std::allocator<int>,
+                                      s21::growth::one_and_half>{5, 6, 8}));
+}
+
+// Its move may throw, so spilling copies it instead; a failed copy must
+// leave every original in place.
+struct ThrowsOnNthCopy {
+  static int copies_left;
+  std::string value;
+
+  explicit ThrowsOnNthCopy(std::string v) : value(std::move(v)) {}
+  ThrowsOnNthCopy(const ThrowsOnNthCopy &other) : value(other.value) {
+    if (--copies_left == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  ThrowsOnNthCopy(ThrowsOnNthCopy &&other) : value(std::move(other.value)) {}
+  ThrowsOnNthCopy &operator=(ThrowsOnNthCopy &&other) = default;
+};
+int ThrowsOnNthCopy::copies_left = 0;
+
+TEST(SmallVectorTest, ThrowingCopyWhileSpillingLeavesElementsInline) {
+  s21::small_vector<ThrowsOnNthCopy, 3> v;
+  for (int i = 0; i < 3; ++i) {
+    v.emplace_back("a string too long for the small buffer " +
+                   std::to_string(i));
+  }
+  for (int fail_at = 1; fail_at <= 3; ++fail_at) {
+    ThrowsOnNthCopy::copies_left = fail_at;
+    EXPECT_THROW(v.emplace_back("x"), std::runtime_error);
+    ThrowsOnNthCopy::copies_left = fail_at;
+    EXPECT_THROW(v.reserve(10), std::runtime_error);
+    EXPECT_TRUE(v.is_inline());
+    ASSERT_EQ(v.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_EQ(v[i].value, "a string too long for the small buffer " +
+                                std::to_string(i));
+    }
+  }
+}
+
+TEST(SmallVectorTest, SwapInlineOfDifferentLengths) {
+  s21::small_vector<std::string, 4> a = {"a", "b", "c"};
+  s21::small_vector<std::string, 4> b = {"z"};
+  a.swap(b);
+  ASSERT_EQ(a.size(), 1);
+  ASSERT_EQ(b.size(), 3);
+  EXPECT_EQ(a[0], "z");
+  EXPECT_EQ(b[2], "c");
+  b.swap(b);
+  EXPECT_EQ(b[0], "a");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+using People = s21::soa_vector<std::string, int, bool>;
+
+static People SomePeople() {
+  return {{"Ann", 31, false}, {"Bob", 19, true}, {"Cid", 24, true}};
+}
+
+// Throws from its copy constructor once armed, to interrupt a row half-way
+// through being added.
+struct Fragile {
+  static inline bool armed = false;
+  int value = 0;
+
+  Fragile(int v) : value(v) {}
+  Fragile(const Fragile &other) : value(other.value) {
+    if (armed) {
+      throw std::runtime_error("copy");
+    }
+  }
+  Fragile(Fragile &&) noexcept = default;
+  Fragile &operator=(const Fragile &) = default;
+  Fragile &operator=(Fragile &&) noexcept = default;
+  bool operator==(const Fragile &) const = default;
+};
+
+TEST(SoaVector, PushBackAndIndex) {
+  People people;
+  EXPECT_TRUE(people.empty());
+  people.push_back({"Ann", 31, false});
+  people.emplace_back("Bob", 19, true);
+  std::string name = "Cid";
+  people.push_back(std::make_tuple(name, 24, true));
+
+  ASSERT_EQ(people.size(), 3u);
+  EXPECT_EQ(std::get<0>(people[1]), "Bob");
+  EXPECT_EQ(std::get<1>(people[2]), 24);
+  EXPECT_EQ(people[0], std::make_tuple("Ann", 31, false));
+  EXPECT_EQ(name, "Cid");
+  EXPECT_EQ(people.capacity(), 4u);
+}
+
+TEST(SoaVector, RowProxyWritesThrough) {
+  People people = SomePeople();
+  auto [name, age, student] = people[0];
+  name += "a";
+  age = 32;
+  student = true;
+  EXPECT_EQ(people.at(0), std::make_tuple("Anna", 32, true));
+
+  people[1] = std::make_tuple("Bo", 20, false);
+  EXPECT_EQ(std::get<0>(people[1]), "Bo");
+  EXPECT_EQ(people.column<1>()[1], 20);
+
+  const People &view = people;
+  EXPECT_EQ(std::get<1>(view.front()), 32);
+  EXPECT_EQ(std::get<0>(view.back()), "Cid");
+}
+
+TEST(SoaVector, ColumnsAreContiguous) {
+  People people = SomePeople();
+  std::span<int> ages = people.column<1>();
+  ASSERT_EQ(ages.size(), 3u);
+  EXPECT_EQ(&ages[1], &std::get<1>(people[1]));
+  EXPECT_EQ(std::accumulate(ages.begin(), ages.end(), 0), 74);
+  EXPECT_EQ(s21::simd::count(ages.data(), ages.size(), 19), 1u);
+
+  std::ranges::sort(people.column<1>());
+  EXPECT_EQ(std::get<1>(people[0]), 19);
+  EXPECT_EQ(std::get<0>(people[0]), "Ann");
+
+  const People &view = people;
+  std::span<const bool> students = view.column<2>();
+  EXPECT_EQ(std::count(students.begin(), students.end(), true), 2);
+}
+
+TEST(SoaVector, Iterators) {
+  People people = SomePeople();
+  int total = 0;
+  for (auto [name, age, student] : people) {
+    age += 1;
+    total += age;
+  }
+  EXPECT_EQ(total, 77);
+  EXPECT_EQ(people.column<1>()[0], 32);
+
+  People::iterator it = people.begin();
+  People::const_iterator last = people.end() - 1;
+  EXPECT_EQ(last - it, 2);
+  EXPECT_TRUE(it < last);
+  EXPECT_EQ(std::get<0>(it[2]), "Cid");
+  EXPECT_EQ(std::get<0>(*++it), "Bob");
+  EXPECT_EQ(std::distance(people.begin(), people.end()), 3);
+
+  auto found = std::find_if(people.begin(), people.end(), [](const auto &row) {
+    return std::get<1>(row) == 25;
+  });
+  EXPECT_EQ(found.index(), 2u);
+}
+
+TEST(SoaVector, EraseAndPopBack) {
+  People people = SomePeople();
+  auto next = people.erase(people.begin());
+  EXPECT_EQ(std::get<0>(*next), "Bob");
+  ASSERT_EQ(people.size(), 2u);
+  EXPECT_EQ(people.column<0>()[1], "Cid");
+  EXPECT_THROW(people.erase(people.end()), std::runtime_error);
+
+  people.pop_back();
+  people.pop_back();
+  EXPECT_TRUE(people.empty());
+  EXPECT_THROW(people.pop_back(), std::runtime_error);
+  EXPECT_THROW(people.front(), std::out_of_range);
+  EXPECT_THROW(people.at(0), std::out_of_range);
+}
+
+TEST(SoaVector, ReserveClearAndCopy) {
+  s21::soa_vector<int, double> points;
+  points.reserve(100);
+  EXPECT_EQ(points.capacity(), 100u);
+  for (int i = 0; i < 1000; ++i) {
+    points.emplace_back(i, i * 0.5);
+  }
+  EXPECT_EQ(points.column<0>().size(), points.column<1>().size());
+  EXPECT_EQ(points.column<1>()[999], 499.5);
+
+  s21::soa_vector<int, double> copy = points;
+  EXPECT_TRUE(copy == points);
+  std::get<1>(copy[10]) = -1.0;
+  EXPECT_FALSE(copy == points);
+
+  points.clear();
+  EXPECT_TRUE(points.empty());
+  points.shrink_to_fit();
+  EXPECT_EQ(points.capacity(), 0u);
+
+  points.swap(copy);
+  EXPECT_EQ(points.size(), 1000u);
+  EXPECT_TRUE(copy.empty());
+}
+
+// Pushing a copy of one of its own rows while the vector grows.
+TEST(SoaVector, PushBackOwnRow) {
+  People people = SomePeople();
+  ASSERT_EQ(people.size(), people.capacity());
+  people.push_back(people[0]);
+  auto [name, age, student] = people[0];
+  people.emplace_back(name, age, student);
+  EXPECT_EQ(people[3], people[0]);
+  EXPECT_EQ(people[4], people[0]);
+}
+
+TEST(SoaVector, ThrowingFieldLeavesColumnsInStep) {
+  s21::soa_vector<int, Fragile, std::string> rows;
+  // With room reserved the row goes straight into the columns, and the
+  // int is already in when the Fragile copy throws.
+  rows.reserve(4);
+  rows.emplace_back(1, Fragile(1), "one");
+  Fragile two(2);
+  Fragile::armed = true;
+  EXPECT_THROW(rows.emplace_back(2, two, "two"), std::runtime_error);
+  Fragile::armed = false;
+  ASSERT_EQ(rows.size(), 1u);
+  EXPECT_EQ(rows.column<0>().size(), 1u);
+  EXPECT_EQ(rows.column<2>().size(), 1u);
+  rows.emplace_back(2, two, "two");
+  EXPECT_EQ(std::get<2>(rows[1]), "two");
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(SpscQueueTest, RoundsCapacityUp) {
+  s21::spsc_queue<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_THROW(s21::spsc_queue<int>(0), std::invalid_argument);
+}
+
+TEST(SpscQueueTest, FifoUntilFull) {
+  s21::spsc_queue<int> queue(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_push(i));
+  }
+  EXPECT_FALSE(queue.try_push(4));
+  EXPECT_EQ(queue.size_approx(), 4);
+
+  int out = -1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, i);
+  }
+  EXPECT_FALSE(queue.try_pop(out));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, WrapsAround) {
+  s21::spsc_queue<std::string> queue(4);
+  std::string out;
+  for (int round = 0; round < 10; ++round) {
+    EXPECT_TRUE(queue.try_emplace(3, static_cast<char>('a' + round)));
+    EXPECT_TRUE(queue.try_push(std::to_string(round)));
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, std::string(3, static_cast<char>('a' + round)));
+    EXPECT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out, std::to_string(round));
+  }
+}
+
+TEST(SpscQueueTest, BatchPushAndPop) {
+  s21::spsc_queue<int> queue(8);
+  std::vector<int> input = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(queue.try_push_batch(input.begin(), input.end()), 8);
+  EXPECT_FALSE(queue.try_push(10));
+
+  int out[5] = {};
+  EXPECT_EQ(queue.try_pop_batch(out, 5), 5);
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[4], 4);
+  EXPECT_EQ(queue.try_push_batch(input.begin() + 8, input.end()), 2);
+
+  std::vector<int> rest;
+  EXPECT_EQ(queue.try_pop_batch(std::back_inserter(rest), 100), 5);
+  EXPECT_EQ(rest, std::vector<int>({5, 6, 7, 8, 9}));
+}
+
+TEST(SpscQueueTest, DestroysLeftovers) {
+  auto tracked = std::make_shared<int>(0);
+  {
+    s21::spsc_queue<std::shared_ptr<int>> queue(4);
+    queue.try_push(tracked);
+    queue.try_push(tracked);
+    EXPECT_EQ(tracked.use_count(), 3);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+// Hands a long sequence through a small queue; the consumer must see every
+// value exactly once and in order. Run under ThreadSanitizer by `make tsan`.
+TEST(SpscQueueStressTest, OrderedHandoff) {
+  constexpr long count = 1000000;
+  s21::spsc_queue<long> queue(64);
+  std::thread producer([&] {
+    for (long i = 0; i < count;) {
+      if (i % 3 == 0) {
+        long batch[7];
+        long size = count - i < 7 ? count - i : 7;
+        for (long j = 0; j < size; ++j) {
+          batch[j] = i + j;
+        }
+        long n = static_cast<long>(queue.try_push_batch(batch, batch + size));
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+        i += n;
+      } else if (queue.try_push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  long expected = 0;
+  bool in_order = true;
+  while (expected < count) {
+    long buffer[16];
+    size_t n = queue.try_pop_batch(buffer, expected % 2 ? 16 : 1);
+    if (n == 0) {
+      std::this_thread::yield();
+    }
+    for (size_t j = 0; j < n; ++j) {
+      in_order &= buffer[j] == expected++;
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(queue.empty());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,274 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+// Hands out memory from new/delete, counting live bytes, and fails the test
+// when asked to free a block it did not hand out.
+class TrackingResource : public std::pmr::memory_resource {
+public:
+  std::size_t live = 0;
+
+private:
+  std::set<void *> blocks_;
+
+  void *do_allocate(std::size_t bytes, std::size_t align) override {
+    void *p = std::pmr::new_delete_resource()->allocate(bytes, align);
+    blocks_.insert(p);
+    live += bytes;
+    return p;
+  }
+  void do_deallocate(void *p, std::size_t bytes, std::size_t align) override {
+    EXPECT_EQ(blocks_.erase(p), 1u) << "freed through the wrong resource";
+    live -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+using IntHashMap = s21::unordered_map<int, int>;
+using StringHashMap = s21::unordered_map<std::string, std::string>;
+
+template <typename Map, typename Oracle>
+void ExpectSameContents(Map &map, const Oracle &oracle) {
+  ASSERT_EQ(map.size(), oracle.size());
+  std::size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    auto found = oracle.find(it->first);
+    ASSERT_NE(found, oracle.end());
+    EXPECT_EQ(it->second, found->second);
+    ++visited;
+  }
+  EXPECT_EQ(visited, oracle.size());
+  for (const auto &[key, value] : oracle) {
+    EXPECT_TRUE(map.contains(key));
+    EXPECT_EQ(map.at(key), value);
+  }
+}
+
+// Every key hashes to the same value, so all probes run through one cluster
+// and erase has to shift long runs back.
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 0; }
+};
+
+// Keys fall into a few home slots, giving overlapping clusters that wrap
+// around the end of the table.
+struct ClusteredHash {
+  std::size_t operator()(int key) const noexcept {
+    return static_cast<std::size_t>(key % 5);
+  }
+};
+
+TEST(UnorderedMapTest, StartsEmpty) {
+  IntHashMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.bucket_count(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.erase(1), 0);
+  EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(UnorderedMapTest, InsertAndAccess) {
+  StringHashMap map = {{"one", "1"}, {"two", "2"}};
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at("one"), "1");
+  EXPECT_EQ(map["two"], "2");
+  EXPECT_THROW(map["three"], std::out_of_range);
+
+  auto [pos, inserted] = map.insert({"one", "uno"});
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(pos->second, "1");
+
+  EXPECT_FALSE(map.insert_or_assign("one", "eins").second);
+  EXPECT_EQ(map.at("one"), "eins");
+  EXPECT_TRUE(map.insert_or_assign("three", "3").second);
+  EXPECT_TRUE(map.emplace("four", "4").second);
+  EXPECT_TRUE(map.try_emplace("five", 2, '5').second);
+  EXPECT_EQ(map.at("five"), "55");
+  EXPECT_EQ(map.size(), 5);
+}
+
+TEST(UnorderedMapTest, EraseByIteratorAndKey) {
+  IntHashMap map = {{1, 10}, {2, 20}, {3, 30}};
+  map.erase(map.find(2));
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.erase(3), 1);
+  EXPECT_EQ(map.erase(3), 0);
+  map.erase(map.end());
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(map.at(1), 10);
+}
+
+TEST(UnorderedMapTest, RandomOpsMatchStdMap) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> key_dist(0, 20000);
+  IntHashMap map;
+  std::map<int, int> oracle;
+  for (int step = 0; step < 200000; ++step) {
+    int key = key_dist(rng);
+    switch (rng() % 3) {
+    case 0:
+      EXPECT_EQ(map.insert(key, step).second,
+                oracle.emplace(key, step).second);
+      break;
+    case 1:
+      map.insert_or_assign(key, -step);
+      oracle[key] = -step;
+      break;
+    default:
+      EXPECT_EQ(map.erase(key), oracle.erase(key));
+    }
+  }
+  ExpectSameContents(map, oracle);
+}
+
+TEST(UnorderedMapTest, BackwardShiftUnderFullCollision) {
+  s21::unordered_map<int, int, CollidingHash> map;
+  std::map<int, int> oracle;
+  for (int i = 0; i < 200; ++i) {
+    map.insert(i, i);
+    oracle.emplace(i, i);
+  }
+  for (int i = 0; i < 200; i += 3) {
+    EXPECT_EQ(map.erase(i), 1);
+    oracle.erase(i);
+  }
+  ExpectSameContents(map, oracle);
+}
+
+TEST(UnorderedMapTest, BackwardShiftAcrossWraparound) {
+  std::mt19937 rng(3);
+  s21::unordered_map<int, int, ClusteredHash> map;
+  std::map<int, int> oracle;
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(rng() % 300);
+    if (rng() % 2) {
+      map.insert(key, key);
+      oracle.emplace(key, key);
+    } else {
+      EXPECT_EQ(map.erase(key), oracle.erase(key));
+    }
+  }
+  ExpectSameContents(map, oracle);
+}
+
+TEST(UnorderedMapTest, ReserveAndRehash) {
+  IntHashMap map;
+  map.reserve(1000);
+  std::size_t buckets = map.bucket_count();
+  EXPECT_GE(buckets * map.max_load_factor(), 1000.0f);
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i, i);
+  }
+  EXPECT_EQ(map.bucket_count(), buckets);
+  EXPECT_LE(map.load_factor(), map.max_load_factor());
+
+  for (int i = 0; i < 990; ++i) {
+    map.erase(i);
+  }
+  map.rehash(0);
+  EXPECT_EQ(map.bucket_count(), 16);
+  for (int i = 990; i < 1000; ++i) {
+    EXPECT_EQ(map.at(i), i);
+  }
+
+  map.rehash(4096);
+  EXPECT_EQ(map.bucket_count(), 4096);
+  EXPECT_EQ(map.size(), 10);
+
+  map.clear();
+  map.rehash(0);
+  EXPECT_EQ(map.bucket_count(), 0);
+}
+
+TEST(UnorderedMapTest, GrowthKeepsAliasedArgument) {
+  StringHashMap map;
+  map.insert({"seed", std::string(100, 's')});
+  for (int i = 0; map.bucket_count() == 16 || i < 20; ++i) {
+    map.try_emplace(std::to_string(i), map.at("seed"));
+  }
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    EXPECT_EQ(it->second, std::string(100, 's'));
+  }
+}
+
+TEST(UnorderedMapTest, CopyMoveAndMerge) {
+  StringHashMap map;
+  for (int i = 0; i < 500; ++i) {
+    map.insert({std::to_string(i), std::to_string(i * i)});
+  }
+  StringHashMap copy(map);
+  copy["7"] = "changed";
+  EXPECT_EQ(map["7"], "49");
+  StringHashMap moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved["7"], "changed");
+
+  StringHashMap target = {{"1", "kept"}, {"x", "y"}};
+  target.merge(map);
+  EXPECT_EQ(target.size(), 501);
+  EXPECT_EQ(target["1"], "kept");
+  ASSERT_EQ(map.size(), 1);
+  EXPECT_EQ(map["1"], "1");
+}
+
+TEST(UnorderedMapTest, PoolAllocator) {
+  s21::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                     s21::pool_allocator<std::pair<const int, std::string>>>
+      map;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert(i, std::to_string(i));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    map.erase(i);
+  }
+  EXPECT_EQ(map.size(), 500);
+  EXPECT_EQ(map.at(999), "999");
+}
+
+// polymorphic_allocator does not propagate on move assignment, so a map
+// moved from one resource into a map on another must keep its own.
+TEST(UnorderedMapTest, MoveAssignAcrossResources) {
+  using PmrHashMap =
+      s21::unordered_map<int, std::string, std::hash<int>, std::equal_to<int>,
+                         std::pmr::polymorphic_allocator<
+                             std::pair<const int, std::string>>>;
+  TrackingResource first;
+  TrackingResource second;
+  {
+    std::pmr::memory_resource *old = std::pmr::set_default_resource(&first);
+    PmrHashMap source;
+    std::pmr::set_default_resource(&second);
+    PmrHashMap target = {{-1, "gone"}};
+    std::pmr::set_default_resource(old);
+    for (int i = 0; i < 1000; ++i) {
+      source.insert(i, std::to_string(i));
+    }
+
+    target = std::move(source);
+    EXPECT_TRUE(source.empty());
+    ASSERT_EQ(target.size(), 1000);
+    EXPECT_FALSE(target.contains(-1));
+    EXPECT_EQ(target.at(999), "999");
+    target.insert(1000, "1000");
+    source.insert(1, "1");
+  }
+  EXPECT_EQ(first.live, 0u);
+  EXPECT_EQ(second.live, 0u);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
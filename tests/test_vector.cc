@@ -1,6 +1,12 @@
 #include "../include/s21/s21_containers.h"
 #include <gtest/gtest.h>
 
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+
 class VectorTest : public testing::Test {
 protected:
   s21::vector<int> int_vec;
@@ -248,6 +254,507 @@ TEST(VectorErase, StressTest) {
   }
 }
 
+TEST(VectorEmplace, EmplaceBackConstructsInPlace) {
+  s21::vector<std::pair<int, std::string>> v;
+  auto &ref = v.emplace_back(1, "one");
+  EXPECT_EQ(ref.first, 1);
+  v.emplace_back(2, "two");
+  EXPECT_EQ(v.size(), 2);
+  EXPECT_EQ(v[1].second, "two");
+}
+
+TEST(VectorEmplace, PushBackRvalueMoves) {
+  s21::vector<std::unique_ptr<int>> v;
+  for (int i = 0; i < 10; ++i) {
+    auto p = std::make_unique<int>(i);
+    v.push_back(std::move(p));
+    EXPECT_EQ(p, nullptr);
+  }
+  EXPECT_EQ(*v[9], 9);
+}
+
+TEST(VectorEmplace, PushBackOwnElementOnGrowth) {
+  s21::vector<std::string> v = {"alpha", "beta"};
+  ASSERT_EQ(v.size(), v.capacity());
+  v.push_back(v[0]);
+  EXPECT_EQ(v[2], "alpha");
+  v.emplace_back(v[1]);
+  EXPECT_EQ(v[3], "beta");
+}
+
+TEST(VectorEmplace, EmplaceInMiddle) {
+  s21::vector<std::string> v = {"a", "c"};
+  v.reserve(8);
+  auto it = v.emplace(v.begin() + 1, 1, 'b');
+  EXPECT_EQ(*it, "b");
+  v.emplace(v.begin(), v[2]);
+  ASSERT_EQ(v.size(), 4);
+  EXPECT_EQ(v[0], "c");
+  EXPECT_EQ(v[1], "a");
+  EXPECT_EQ(v[2], "b");
+  EXPECT_EQ(v[3], "c");
+  EXPECT_THROW(v.emplace(v.begin() + 5, "x"), std::out_of_range);
+}
+
+TEST(VectorEmplace, InsertIntoEmptyReservedVector) {
+  s21::vector<int> v;
+  v.reserve(4);
+  v.insert(v.begin(), 7);
+  EXPECT_EQ(v.size(), 1);
+  EXPECT_EQ(v[0], 7);
+}
+
+struct Relocatable {
+  static int moves;
+  int *value;
+
+  explicit Relocatable(int v) : value(new int(v)) {}
+  Relocatable(Relocatable &&other) noexcept : value(other.value) {
+    other.value = nullptr;
+    ++moves;
+  }
+  Relocatable &operator=(Relocatable &&other) noexcept {
+    std::swap(value, other.value);
+    ++moves;
+    return *this;
+  }
+  ~Relocatable() { delete value; }
+};
+int Relocatable::moves = 0;
+
+template <> struct s21::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+// Counts live objects; relocatable bitwise, but with a destructor.
+struct Tracked {
+  static int alive;
+  int value;
+
+  explicit Tracked(int v) : value(v) { ++alive; }
+  Tracked(const Tracked &other) : value(other.value) { ++alive; }
+  ~Tracked() { --alive; }
+};
+int Tracked::alive = 0;
+
+template <> struct s21::is_trivially_relocatable<Tracked> : std::true_type {};
+
+// Has a realloc-style reallocate() that always fails.
+template <typename T> struct FailingReallocator {
+  using value_type = T;
+
+  FailingReallocator() = default;
+  template <typename U> FailingReallocator(const FailingReallocator<U> &) {}
+
+  T *allocate(size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T *p, size_t n) noexcept {
+    std::allocator<T>().deallocate(p, n);
+  }
+  T *reallocate(T *, size_t, size_t) { throw std::bad_alloc(); }
+  bool operator==(const FailingReallocator &) const { return true; }
+};
+
+TEST(VectorRelocation, FailedReallocateDestroysStagedElement) {
+  Tracked::alive = 0;
+  {
+    s21::vector<Tracked, FailingReallocator<Tracked>> v;
+    v.emplace_back(1);
+    EXPECT_THROW(v.emplace_back(2), std::bad_alloc);
+    EXPECT_EQ(Tracked::alive, 1);
+    EXPECT_THROW(v.emplace(v.begin(), 3), std::bad_alloc);
+    EXPECT_EQ(Tracked::alive, 1);
+    ASSERT_EQ(v.size(), 1);
+    EXPECT_EQ(v[0].value, 1);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(VectorRelocation, TriviallyCopyableOpsKeepOrder) {
+  struct Sample {
+    double t;
+    int id;
+  };
+  static_assert(s21::is_trivially_relocatable_v<Sample>);
+  s21::vector<Sample> v;
+  for (int i = 0; i < 100; ++i)
+    v.push_back({i * 0.5, i});
+  v.insert(v.begin() + 10, {-1.0, -1});
+  v.erase(v.begin());
+  v.reserve(1000);
+  v.shrink_to_fit();
+
+  ASSERT_EQ(v.size(), 100);
+  EXPECT_EQ(v.capacity(), 100);
+  EXPECT_EQ(v[0].id, 1);
+  EXPECT_EQ(v[9].id, -1);
+  EXPECT_EQ(v[10].id, 10);
+  EXPECT_EQ(v[99].id, 99);
+}
+
+TEST(VectorRelocation, OptInTypeIsNeverMoved) {
+  static_assert(!std::is_trivially_copyable_v<Relocatable>);
+  Relocatable::moves = 0;
+  {
+    s21::vector<Relocatable> v;
+    for (int i = 0; i < 64; ++i)
+      v.emplace_back(i);
+    v.emplace(v.begin() + 3, 100);
+    v.emplace(v.begin(), 200);
+    v.erase(v.begin() + 1);
+    v.reserve(512);
+    v.shrink_to_fit();
+    v.pop_back();
+
+    ASSERT_EQ(v.size(), 64);
+    EXPECT_EQ(*v[0].value, 200);
+    EXPECT_EQ(*v[1].value, 1);
+    EXPECT_EQ(*v[2].value, 2);
+    EXPECT_EQ(*v[3].value, 100);
+    EXPECT_EQ(*v[63].value, 62);
+  }
+  EXPECT_EQ(Relocatable::moves, 0);
+}
+
+TEST(VectorRelocation, EraseAndPopBackDestroyNonTrivialElements) {
+  s21::vector<std::string> v = {"a", "b", "c", "d"};
+  v.erase(v.begin() + 1);
+  v.pop_back();
+  ASSERT_EQ(v.size(), 2);
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "c");
+  EXPECT_THROW(v.erase(v.end()), std::runtime_error);
+}
+
+TEST(VectorAccess, ConstAndMutableOverloads) {
+  s21::vector<int> v = {1, 2, 3};
+  const s21::vector<int> &cv = v;
+  static_assert(std::is_same_v<decltype(v[0]), int &>);
+  static_assert(std::is_same_v<decltype(cv[0]), const int &>);
+  static_assert(std::is_same_v<decltype(v.at(0)), int &>);
+  static_assert(std::is_same_v<decltype(cv.at(0)), const int &>);
+  static_assert(noexcept(v[0]));
+
+  v[1] = 20;
+  v.at(2) = 30;
+  EXPECT_EQ(cv[1], 20);
+  EXPECT_EQ(cv.at(2), 30);
+  EXPECT_THROW(cv.at(3), std::out_of_range);
+}
+
+// Stateful allocator that counts live bytes in a shared counter and does
+// not propagate on move assignment, so unequal instances must not share
+// storage.
+template <typename T> struct CountingAllocator {
+  using value_type = T;
+  using propagate_on_container_move_assignment = std::false_type;
+  using is_always_equal = std::false_type;
+
+  std::shared_ptr<long> live;
+
+  explicit CountingAllocator(std::shared_ptr<long> counter)
+      : live(std::move(counter)) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &other) : live(other.live) {}
+
+  T *allocate(size_t n) {
+    *live += static_cast<long>(n * sizeof(T));
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+  void deallocate(T *p, size_t n) noexcept {
+    *live -= static_cast<long>(n * sizeof(T));
+    ::operator delete(p);
+  }
+  bool operator==(const CountingAllocator &other) const {
+    return live == other.live;
+  }
+};
+
+TEST(VectorAllocator, StorageGoesThroughAllocator) {
+  auto live = std::make_shared<long>(0);
+  {
+    CountingAllocator<std::string> alloc(live);
+    s21::vector<std::string, CountingAllocator<std::string>> v(alloc);
+    for (int i = 0; i < 100; ++i) {
+      v.push_back(std::to_string(i));
+    }
+    v.insert(v.begin(), "front");
+    v.shrink_to_fit();
+    EXPECT_EQ(*live, static_cast<long>(v.capacity() * sizeof(std::string)));
+    EXPECT_EQ(v.get_allocator(), alloc);
+
+    auto copy = v;
+    EXPECT_EQ(copy.get_allocator(), alloc);
+    EXPECT_EQ(copy[0], "front");
+  }
+  EXPECT_EQ(*live, 0);
+}
+
+TEST(VectorAllocator, MoveAssignBetweenUnequalAllocators) {
+  auto first = std::make_shared<long>(0);
+  auto second = std::make_shared<long>(0);
+  using Vector = s21::vector<int, CountingAllocator<int>>;
+  {
+    Vector a({1, 2, 3}, CountingAllocator<int>(first));
+    Vector b({4, 5}, CountingAllocator<int>(second));
+    b = std::move(a);
+    // b keeps its own allocator, so the elements were moved into new
+    // storage from it and a's block stays with a.
+    EXPECT_EQ(b.get_allocator().live, second);
+    ASSERT_EQ(b.size(), 3);
+    EXPECT_EQ(b[2], 3);
+    EXPECT_EQ(*first, static_cast<long>(a.capacity() * sizeof(int)));
+    EXPECT_EQ(*second, static_cast<long>(b.capacity() * sizeof(int)));
+
+    Vector c{CountingAllocator<int>(second)};
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_TRUE(b.empty());
+  }
+  EXPECT_EQ(*first, 0);
+  EXPECT_EQ(*second, 0);
+}
+
+TEST(VectorAllocator, MoveKeepsCapacityAndFreesTarget) {
+  s21::vector<int> source;
+  source.reserve(64);
+  source.push_back(1);
+  s21::vector<int> moved(std::move(source));
+  EXPECT_EQ(moved.capacity(), 64);
+
+  s21::vector<int> target = {7, 8, 9};
+  target = std::move(moved);
+  EXPECT_EQ(target.capacity(), 64);
+  ASSERT_EQ(target.size(), 1);
+  EXPECT_EQ(target[0], 1);
+}
+
+TEST(VectorAllocator, PmrVectorUsesResource) {
+  alignas(std::max_align_t) unsigned char buffer[4096];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::vector<std::pmr::string> v(&arena);
+  v.emplace_back("a string long enough to need its own heap block");
+  v.push_back(std::pmr::string("short"));
+  v.reserve(8);
+
+  // The elements were built with the vector's resource.
+  EXPECT_EQ(v[0].get_allocator().resource(), &arena);
+  EXPECT_EQ(v[1].get_allocator().resource(), &arena);
+  EXPECT_THROW(v.reserve(1000), std::bad_alloc);
+  EXPECT_EQ(v.size(), 2);
+}
+
+TEST(VectorAllocator, PmrCopyUsesDefaultResource) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::vector<int> v({1, 2, 3}, &arena);
+  s21::pmr::vector<int> copy = v;
+  EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+
+  s21::pmr::vector<int> assigned(&arena);
+  assigned = copy;
+  EXPECT_EQ(assigned.get_allocator().resource(), &arena);
+  EXPECT_EQ(assigned.size(), 3);
+}
+
+TEST(VectorBulkInsert, RangeInsertReallocatesOnce) {
+  s21::vector<int> v = {1, 2, 3};
+  std::list<int> extra = {10, 11, 12, 13, 14};
+  auto it = v.insert(v.begin() + 1, extra.begin(), extra.end());
+  EXPECT_EQ(it, v.begin() + 1);
+  EXPECT_EQ(v.capacity(), 8);
+  ASSERT_EQ(v.size(), 8);
+  int expected[] = {1, 10, 11, 12, 13, 14, 2, 3};
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_EQ(v[i], expected[i]);
+  }
+
+  v.reserve(20);
+  v.insert(v.begin(), {-2, -1});
+  EXPECT_EQ(v[0], -2);
+  EXPECT_EQ(v[2], 1);
+  EXPECT_EQ(v[9], 3);
+  EXPECT_EQ(v.capacity(), 20);
+}
+
+TEST(VectorBulkInsert, NonTrivialElementsInPlace) {
+  s21::vector<std::string> v = {"a", "e"};
+  v.reserve(10);
+  std::string middle[] = {"b", "c", "d"};
+  v.insert(v.begin() + 1, std::begin(middle), std::end(middle));
+  v.insert(v.end(), 2, std::string("z"));
+  ASSERT_EQ(v.size(), 7);
+  EXPECT_EQ(v[1], "b");
+  EXPECT_EQ(v[3], "d");
+  EXPECT_EQ(v[4], "e");
+  EXPECT_EQ(v[6], "z");
+  EXPECT_EQ(v.capacity(), 10);
+}
+
+TEST(VectorBulkInsert, InputIteratorsAndCountOfOwnElement) {
+  s21::vector<int> v = {1, 5};
+  std::istringstream input("2 3 4");
+  v.insert(v.begin() + 1, std::istream_iterator<int>(input),
+           std::istream_iterator<int>());
+  ASSERT_EQ(v.size(), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(v[i], i + 1);
+  }
+
+  v.insert(v.begin(), 3, v[4]);
+  ASSERT_EQ(v.size(), 8);
+  EXPECT_EQ(v[0], 5);
+  EXPECT_EQ(v[2], 5);
+  EXPECT_EQ(v[3], 1);
+  EXPECT_THROW(v.insert(v.end() + 1, 2, 0), std::out_of_range);
+}
+
+struct ThrowsOnThirdCopy {
+  static int copies;
+  int value;
+
+  explicit ThrowsOnThirdCopy(int v) : value(v) {}
+  ThrowsOnThirdCopy(const ThrowsOnThirdCopy &other) : value(other.value) {
+    if (++copies == 3) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  ThrowsOnThirdCopy(ThrowsOnThirdCopy &&other) noexcept = default;
+  ThrowsOnThirdCopy &operator=(ThrowsOnThirdCopy &&other) noexcept = default;
+};
+int ThrowsOnThirdCopy::copies = 0;
+
+TEST(VectorBulkInsert, ThrowingCopyLeavesVectorUnchanged) {
+  s21::vector<ThrowsOnThirdCopy> v;
+  v.emplace_back(1);
+  v.emplace_back(2);
+  std::vector<ThrowsOnThirdCopy> source;
+  source.reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    source.emplace_back(9);
+  }
+  ThrowsOnThirdCopy::copies = 0;
+  EXPECT_THROW(v.insert(v.begin() + 1, source.begin(), source.end()),
+               std::runtime_error);
+  ASSERT_EQ(v.size(), 2);
+  EXPECT_EQ(v[0].value, 1);
+  EXPECT_EQ(v[1].value, 2);
+}
+
+// Its move may throw, so growing copies it instead; the copies owe nothing
+// to the originals, which must survive a failed one untouched.
+struct ThrowsOnNthCopy {
+  static int copies_left;
+  std::string value;
+
+  explicit ThrowsOnNthCopy(std::string v) : value(std::move(v)) {}
+  ThrowsOnNthCopy(const ThrowsOnNthCopy &other) : value(other.value) {
+    if (--copies_left == 0) {
+      throw std::runtime_error("copy failed");
+    }
+  }
+  ThrowsOnNthCopy(ThrowsOnNthCopy &&other) : value(std::move(other.value)) {}
+  ThrowsOnNthCopy &operator=(ThrowsOnNthCopy &&other) = default;
+};
+int ThrowsOnNthCopy::copies_left = 0;
+
+TEST(VectorRelocation, ThrowingCopyWhileGrowingLeavesVectorUnchanged) {
+  s21::vector<ThrowsOnNthCopy> v;
+  v.reserve(4);
+  for (int i = 0; i < 4; ++i) {
+    v.emplace_back("a string too long for the small buffer " +
+                   std::to_string(i));
+  }
+  for (int fail_at = 1; fail_at <= 4; ++fail_at) {
+    ThrowsOnNthCopy::copies_left = fail_at;
+    EXPECT_THROW(v.reserve(8), std::runtime_error);
+    ThrowsOnNthCopy::copies_left = fail_at;
+    EXPECT_THROW(v.emplace_back("x"), std::runtime_error);
+    ThrowsOnNthCopy::copies_left = fail_at;
+    EXPECT_THROW(v.emplace(v.begin() + 1, "y"), std::runtime_error);
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v.capacity(), 4);
+    for (int i = 0; i < 4; ++i) {
+      EXPECT_EQ(v[i].value, "a string too long for the small buffer " +
+                                std::to_string(i));
+    }
+  }
+  ThrowsOnNthCopy::copies_left = 0;
+  v.reserve(8);
+  EXPECT_EQ(v[3].value, "a string too long for the small buffer 3");
+}
+
+TEST(VectorBulkInsert, AppendRangeAndAssign) {
+  s21::vector<int> v;
+  std::vector<int> source(100, 7);
+  v.append_range(source);
+  EXPECT_EQ(v.size(), 100);
+  EXPECT_EQ(v.capacity(), 100);
+
+  std::istringstream input("1 2 3");
+  v.append_range(std::ranges::istream_view<int>(input));
+  EXPECT_EQ(v.size(), 103);
+  EXPECT_EQ(v[102], 3);
+
+  v.assign(5, v[0]);
+  EXPECT_EQ(v.size(), 5);
+  EXPECT_EQ(v[4], 7);
+  EXPECT_EQ(v.capacity(), 200);
+
+  v.assign({4, 5, 6});
+  ASSERT_EQ(v.size(), 3);
+  EXPECT_EQ(v[2], 6);
+
+  s21::vector<std::string> words;
+  std::list<std::string> list = {"x", "y"};
+  words.assign(list.begin(), list.end());
+  EXPECT_EQ(words.capacity(), 2);
+  EXPECT_EQ(words[1], "y");
+}
+
+TEST(VectorGrowth, PoliciesBoundOvershoot) {
+  s21::vector<int, std::allocator<int>, s21::growth::one_and_half> v;
+  s21::vector<int> doubled;
+  size_t expected[] = {1, 2, 3, 4, 6, 9, 13, 19};
+  for (size_t i = 0; i < 19; ++i) {
+    v.push_back(static_cast<int>(i));
+    doubled.push_back(static_cast<int>(i));
+  }
+  EXPECT_EQ(v.capacity(), expected[7]);
+  EXPECT_EQ(doubled.capacity(), 32);
+
+  using PageVector =
+      s21::vector<double, std::allocator<double>, s21::growth::page_rounded<>>;
+  PageVector pages;
+  for (int i = 0; i < 100000; ++i) {
+    pages.push_back(i);
+    if (pages.capacity() * sizeof(double) >= 4096) {
+      EXPECT_EQ(pages.capacity() * sizeof(double) % 4096, 0);
+    }
+  }
+  EXPECT_LE(pages.capacity(), 100000 * 3 / 2 + 512);
+}
+
+// Elements larger than a page, where rounding to whole pages alone would
+// not grow the buffer at all.
+TEST(VectorGrowth, PageRoundedGrowsPageSizedElements) {
+  struct Big {
+    char bytes[5000];
+  };
+  EXPECT_GT(s21::growth::page_rounded<>::next(1, sizeof(Big)), 1);
+  using BigVector =
+      s21::vector<Big, std::allocator<Big>, s21::growth::page_rounded<>>;
+  BigVector v;
+  for (int i = 0; i < 10; ++i) {
+    Big big;
+    big.bytes[0] = static_cast<char>(i);
+    v.push_back(big);
+  }
+  EXPECT_EQ(v.size(), 10);
+  EXPECT_EQ(v[9].bytes[0], 9);
+  for (size_t capacity = 1; capacity < 64; ++capacity) {
+    EXPECT_GT(s21::growth::page_rounded<>::next(capacity, 4096), capacity);
+    EXPECT_GT(s21::growth::page_rounded<>::next(capacity, 8192), capacity);
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
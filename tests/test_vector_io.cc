@@ -0,0 +1,198 @@
+#include "../include/s21/s21_containers.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+struct Sample {
+  std::int64_t time;
+  float value;
+};
+
+static s21::vector<int> Iota(int n) {
+  s21::vector<int> v;
+  for (int i = 0; i < n; ++i) {
+    v.push_back(i);
+  }
+  return v;
+}
+
+// Dumps go through a descriptor on a scratch file named after the test,
+// in ::testing::TempDir().
+class VectorIoTest : public ::testing::Test {
+protected:
+  std::string path =
+      ::testing::TempDir() + "s21_vector_io_" + std::to_string(::getpid()) +
+      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+
+  void TearDown() override { std::remove(path.c_str()); }
+
+  int open_for_write() {
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  }
+  int open_for_read() { return ::open(path.c_str(), O_RDONLY); }
+};
+
+TEST_F(VectorIoTest, DescriptorRoundTrip) {
+  s21::vector<int> v = Iota(100000);
+  int fd = open_for_write();
+  v.write_to(fd);
+  ::close(fd);
+
+  s21::vector<int> loaded;
+  fd = open_for_read();
+  loaded.read_from(fd);
+  ::close(fd);
+  ASSERT_EQ(loaded.size(), v.size());
+  EXPECT_EQ(loaded.capacity(), v.size());
+  for (size_t i = 0; i < v.size(); ++i) {
+    ASSERT_EQ(loaded[i], v[i]);
+  }
+}
+
+TEST_F(VectorIoTest, StreamRoundTrip) {
+  s21::vector<Sample> v;
+  v.push_back({1, 0.5f});
+  v.push_back({2, 1.5f});
+  std::stringstream buffer;
+  v.write_to(buffer);
+  EXPECT_EQ(buffer.str().size(), sizeof(s21::vector_io::header) +
+                                     2 * sizeof(Sample));
+
+  s21::vector<Sample> loaded = {{9, 9.0f}};
+  loaded.read_from(buffer);
+  ASSERT_EQ(loaded.size(), 2u);
+  EXPECT_EQ(loaded[1].time, 2);
+  EXPECT_EQ(loaded[1].value, 1.5f);
+}
+
+TEST_F(VectorIoTest, EmptyRoundTrip) {
+  s21::vector<double> v;
+  std::stringstream buffer;
+  v.write_to(buffer);
+
+  s21::vector<double> loaded = {1.0, 2.0};
+  loaded.read_from(buffer);
+  EXPECT_TRUE(loaded.empty());
+}
+
+TEST_F(VectorIoTest, ReadReusesStorage) {
+  std::stringstream buffer;
+  Iota(10).write_to(buffer);
+
+  s21::vector<int> loaded;
+  loaded.reserve(100);
+  int *storage = loaded.data();
+  loaded.read_from(buffer);
+  EXPECT_EQ(loaded.data(), storage);
+  EXPECT_EQ(loaded.size(), 10u);
+  EXPECT_EQ(loaded.back(), 9);
+}
+
+TEST_F(VectorIoTest, ReaderLoadsInChunks) {
+  s21::vector<std::int64_t> v;
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(i * 3);
+  }
+  std::stringstream buffer;
+  v.write_to(buffer);
+
+  // 100-byte chunks end in the middle of elements.
+  s21::vector_reader<s21::vector<std::int64_t>> reader(
+      buffer, s21::vector<std::int64_t>(), 100);
+  EXPECT_EQ(reader.size(), 1000u);
+  EXPECT_EQ(reader.loaded(), 0u);
+  const std::int64_t *storage = reader.elements().data();
+  int chunks = 0;
+  while (reader.read_chunk()) {
+    ++chunks;
+    EXPECT_EQ(reader.loaded(), std::min<size_t>(chunks * 100 / 8, 1000));
+    if (reader.loaded() > 0) {
+      EXPECT_EQ(reader.elements().back(),
+                static_cast<std::int64_t>(reader.loaded() - 1) * 3);
+    }
+  }
+  EXPECT_EQ(chunks, 80);
+  EXPECT_TRUE(reader.done());
+  s21::vector<std::int64_t> loaded = std::move(reader).take();
+  EXPECT_EQ(loaded.data(), storage);
+  EXPECT_EQ(loaded.size(), 1000u);
+  EXPECT_EQ(loaded[999], 2997);
+}
+
+TEST_F(VectorIoTest, ReaderFromPipe) {
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  s21::vector<int> v = Iota(1000);
+  v.write_to(fds[1]);
+  ::close(fds[1]);
+
+  s21::vector<int> loaded =
+      s21::vector_reader<s21::vector<int>>(fds[0]).take();
+  ::close(fds[0]);
+  ASSERT_EQ(loaded.size(), 1000u);
+  EXPECT_EQ(loaded[500], 500);
+}
+
+TEST_F(VectorIoTest, RejectsBadDumps) {
+  std::stringstream buffer;
+  Iota(4).write_to(buffer);
+  std::string bytes = buffer.str();
+
+  s21::vector<int> loaded = {1, 2, 3};
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+  EXPECT_THROW(loaded.read_from(truncated), std::runtime_error);
+  EXPECT_TRUE(loaded.empty());
+
+  std::stringstream short_header(bytes.substr(0, 10));
+  EXPECT_THROW(loaded.read_from(short_header), std::runtime_error);
+
+  std::string corrupt = bytes;
+  corrupt[offsetof(s21::vector_io::header, count)] ^= 1;
+  std::stringstream corrupt_stream(corrupt);
+  EXPECT_THROW(loaded.read_from(corrupt_stream), std::runtime_error);
+
+  std::stringstream other_type(bytes);
+  s21::vector<double> doubles;
+  EXPECT_THROW(doubles.read_from(other_type), std::runtime_error);
+
+  EXPECT_THROW(loaded.read_from(-1), std::system_error);
+  EXPECT_THROW(Iota(1).write_to(-1), std::system_error);
+}
+
+TEST_F(VectorIoTest, PmrVectorRoundTrip) {
+  std::pmr::monotonic_buffer_resource arena;
+  s21::pmr::vector<int> v{std::pmr::polymorphic_allocator<int>(&arena)};
+  v.push_back(7);
+  std::stringstream buffer;
+  v.write_to(buffer);
+
+  s21::pmr::vector<int> loaded{std::pmr::polymorphic_allocator<int>(&arena)};
+  loaded.read_from(buffer);
+  ASSERT_EQ(loaded.size(), 1u);
+  EXPECT_EQ(loaded[0], 7);
+  EXPECT_EQ(loaded.get_allocator().resource(), &arena);
+}
+
+TEST(VectorResizeAndOverwrite, KeepsWhatOpReturns) {
+  s21::vector<int> v = {1, 2};
+  v.resize_and_overwrite(10, [](int *data, size_t n) {
+    EXPECT_EQ(data[1], 2);
+    for (size_t i = 2; i < n; ++i) {
+      data[i] = static_cast<int>(i);
+    }
+    return size_t{6};
+  });
+  EXPECT_EQ(v.size(), 6u);
+  EXPECT_EQ(v.capacity(), 10u);
+  EXPECT_EQ(v[5], 5);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}